@@ -22,6 +22,7 @@
 #include "game-event.h"
 #include "game-cmd.h"
 #include "history.h"
+#include "monster/mon-make.h"
 #include "object/inventory.h"
 #include "object/tvalsval.h"
 #include "object/object.h"
@@ -442,6 +443,7 @@ void player_init(struct player *p)
 		k_ptr->tried = FALSE;
 		k_ptr->aware = FALSE;
 	}
+	object_flags_forget(NULL);
 
 	for (i = 1; z_info && i < z_info->r_max; i++)
 	{
@@ -459,6 +461,8 @@ void player_init(struct player *p)
 	if (z_info)
 		r_info[z_info->r_max-1].max_num = 0;
 
+	get_mon_num_reset();
+
 
 	/* Always start with a well fed player (this is surely in the wrong fn) */
 	p->food = PY_FOOD_FULL - 1;
@@ -9380,6 +9380,180 @@ int borg_danger_aux(int y, int x, int c, int i, bool average, bool full_damage)
 }
 
 
+/*
+ * The danger map
+ *
+ * While the borg decides what to do, the same grids are asked about over
+ * and over (flowing, caution, escapes, attack simulations), and each answer
+ * costs a trip through borg_danger_aux() for every monster.  So while the
+ * map is on, the answer for each grid is kept, along with the "immediate
+ * threats" it left behind, and handed back while nothing it was worked out
+ * from has changed.
+ *
+ * The monsters, the map and the fear arrays are only expected to change
+ * between decisions, and anything that changes them during one must call
+ * borg_danger_forget() or borg_danger_forget_all().  Everything else the
+ * danger depends on is in borg_danger_state.  Simulations flip those back
+ * and forth (trying on equipment, casting a spell, standing elsewhere), so
+ * the last few states are remembered, each with its own mark, and a grid
+ * marked under one of them is good again once the borg is back in it.
+ */
+struct borg_danger_state
+{
+    int skill[BI_MAX];
+    int stat[6];
+    s16b stat_ind[6];
+    s32b gold;
+    int c_x, c_y;
+    int fighting_unique;
+    int tp_other_n;
+    int tp_other_index[255];
+    byte position;
+    bool short_panel, long_panel, long_game;
+    bool speed, slow_spell, sleep_spell, sleep_spell_ii, confuse_spell,
+        fear_mon_spell, attacking, create_door, prot_from_evil, shield, stone,
+        on_glyph;
+};
+
+/* The last few states, and the marks grids get under them */
+#define DANGER_STATES   4
+
+static struct borg_danger_state borg_danger_states[DANGER_STATES];
+static u32b borg_danger_marks[DANGER_STATES];
+static int borg_danger_now;
+
+/* The danger of a grid, for one set of arguments */
+typedef struct borg_danger_grid
+{
+    u32b when;
+    s16b p;
+    byte c;
+    byte flags;
+} borg_danger_grid;
+
+#define DANGER_AVERAGE  0x01
+#define DANGER_FULL     0x02
+#define DANGER_CONF     0x04
+#define DANGER_BLIND    0x08
+#define DANGER_PARA     0x10
+#define DANGER_INVIS    0x20
+
+static borg_danger_grid borg_danger_map[AUTO_MAX_Y][AUTO_MAX_X];
+
+/* Whether the map is on */
+static bool borg_danger_on;
+
+/* The newest mark handed out */
+static u32b borg_danger_last;
+
+/*
+ * Forget the danger of every grid
+ */
+void borg_danger_forget_all(void)
+{
+    int i;
+
+    /* Zero is never a mark, so also wipes the states */
+    for (i = 0; i < DANGER_STATES; i++)
+        borg_danger_marks[i] = 0;
+}
+
+/*
+ * Forget the danger of the grids a monster at (y,x) has a part in.  It is
+ * no danger past 20 grids, and a neighbour checks its grid when moving up
+ * to attack grids another two away.
+ */
+void borg_danger_forget(int y, int x)
+{
+    int y1, x1, y2, x2;
+
+    if (!borg_danger_on) return;
+
+    y1 = MAX(y - 22, 0);
+    x1 = MAX(x - 22, 0);
+    y2 = MIN(y + 22, AUTO_MAX_Y - 1);
+    x2 = MIN(x + 22, AUTO_MAX_X - 1);
+
+    for (y = y1; y <= y2; y++)
+    {
+        for (x = x1; x <= x2; x++)
+            borg_danger_map[y][x].when = 0;
+    }
+}
+
+/*
+ * Start or stop keeping the danger of each grid.  Nothing kept from an
+ * earlier decision is trusted.
+ */
+void borg_danger_keep(bool on)
+{
+    borg_danger_forget_all();
+    borg_danger_on = on;
+}
+
+/*
+ * Find the mark for the state borg_danger() is now working in
+ */
+static u32b borg_danger_mark(void)
+{
+    static struct borg_danger_state now;
+    int i, n = MIN(MAX(borg_tp_other_n + 1, 0), 255);
+
+    WIPE(&now, struct borg_danger_state);
+    memcpy(now.skill, borg_skill, sizeof(now.skill));
+    memcpy(now.stat, borg_stat, sizeof(now.stat));
+    memcpy(now.stat_ind, my_stat_ind, sizeof(now.stat_ind));
+    now.gold = borg_gold;
+    now.c_x = c_x;
+    now.c_y = c_y;
+    now.fighting_unique = borg_fighting_unique;
+    now.tp_other_n = borg_tp_other_n;
+    if (borg_tp_other_n)
+        memcpy(now.tp_other_index, borg_tp_other_index, n * sizeof(int));
+    now.position = borg_position;
+    now.short_panel = (time_this_panel <= 200);
+    now.long_panel = (time_this_panel > 1200);
+    now.long_game = (borg_t > 25000);
+    now.speed = borg_speed;
+    now.slow_spell = borg_slow_spell;
+    now.sleep_spell = borg_sleep_spell;
+    now.sleep_spell_ii = borg_sleep_spell_ii;
+    now.confuse_spell = borg_confuse_spell;
+    now.fear_mon_spell = borg_fear_mon_spell;
+    now.attacking = borg_attacking;
+    now.create_door = borg_create_door;
+    now.prot_from_evil = borg_prot_from_evil;
+    now.shield = borg_shield;
+    now.stone = borg_stone;
+    now.on_glyph = borg_on_glyph;
+
+    /* Usually nothing has changed */
+    i = borg_danger_now;
+    if (borg_danger_marks[i] &&
+        !memcmp(&now, &borg_danger_states[i], sizeof(now)))
+        return (borg_danger_marks[i]);
+
+    /* Perhaps a simulation has put things back */
+    for (i = 0; i < DANGER_STATES; i++)
+    {
+        if (borg_danger_marks[i] &&
+            !memcmp(&now, &borg_danger_states[i], sizeof(now)))
+        {
+            borg_danger_now = i;
+            return (borg_danger_marks[i]);
+        }
+    }
+
+    /* Replace the next state in turn */
+    i = (borg_danger_now + 1) % DANGER_STATES;
+    COPY(&borg_danger_states[i], &now, struct borg_danger_state);
+    borg_danger_marks[i] = ++borg_danger_last;
+    borg_danger_now = i;
+
+    return (borg_danger_marks[i]);
+}
+
+
 /*
  * Hack -- Calculate the "danger" of the given grid.
  *
@@ -9405,6 +9579,26 @@ int borg_danger(int y, int x, int c, bool average, bool full_damage)
 {
     int i, p=0;
 
+    borg_danger_grid *dg = &borg_danger_map[y][x];
+    byte how = (average ? DANGER_AVERAGE : 0) | (full_damage ? DANGER_FULL : 0);
+    u32b when = 0;
+
+    /* Use the map if this grid is up to date */
+    if (borg_danger_on)
+    {
+        when = borg_danger_mark();
+
+        if (dg->when == when && dg->c == c &&
+            (dg->flags & (DANGER_AVERAGE | DANGER_FULL)) == how)
+        {
+            borg_threat_conf = (dg->flags & DANGER_CONF) ? TRUE : FALSE;
+            borg_threat_blind = (dg->flags & DANGER_BLIND) ? TRUE : FALSE;
+            borg_threat_para = (dg->flags & DANGER_PARA) ? TRUE : FALSE;
+            borg_threat_invis = (dg->flags & DANGER_INVIS) ? TRUE : FALSE;
+            return (dg->p);
+        }
+    }
+
     /* Base danger (from regional fear) but not within a vault.  Cheating the floor grid */
 	if (!(cave->info[y][x] & (CAVE_ICKY)) && borg_skill[BI_CDEPTH] <= 70)
 	{
@@ -9440,8 +9634,24 @@ int borg_danger(int y, int x, int c, bool average, bool full_damage)
         p += borg_danger_aux(y, x, c, i, average, full_damage);
     }
 
+    /* Maximal danger */
+    if (p > 2000) p = 2000;
+
+    /* Mark the map */
+    if (when && c >= 0 && c <= 255)
+    {
+        dg->when = when;
+        dg->p = p;
+        dg->c = c;
+        dg->flags = how;
+        if (borg_threat_conf) dg->flags |= DANGER_CONF;
+        if (borg_threat_blind) dg->flags |= DANGER_BLIND;
+        if (borg_threat_para) dg->flags |= DANGER_PARA;
+        if (borg_threat_invis) dg->flags |= DANGER_INVIS;
+    }
+
     /* Return the danger */
-    return (p > 2000 ? 2000 : p);
+    return (p);
 }
 
 
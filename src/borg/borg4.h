@@ -61,6 +61,13 @@ extern int borg_danger_aux(int y, int x, int c, int i, bool average, bool full_d
  */
 extern int borg_danger(int y, int x, int c, bool average, bool full_damage);
 
+/*
+ * Start or stop keeping the danger of each grid, and forget what was kept
+ */
+extern void borg_danger_keep(bool on);
+extern void borg_danger_forget(int y, int x);
+extern void borg_danger_forget_all(void);
+
 
 /*
  * Determine if the Borg is out of "crucial" supplies.
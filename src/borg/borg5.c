@@ -4,6 +4,7 @@
 #include "angband.h"
 #include "object/tvalsval.h"
 #include "cave.h"
+#include "game-event.h"
 #include "monster/mon-spell.h"
 
 #include "borg1.h"
@@ -124,6 +125,44 @@ static int borg_wank_num = 0;
 static borg_wank *borg_wanks;
 
 
+/*
+ * Hack -- the monster/object "wank" (if any) the last look at each grid saw
+ */
+
+typedef struct borg_look borg_look;
+
+struct borg_look
+{
+    byte t_a;
+    wchar_t t_c;
+
+    bool is_take;
+    bool is_kill;
+};
+
+static borg_look borg_looks[AUTO_MAX_Y][AUTO_MAX_X];
+
+/* Number of "wanks" in each row of looks */
+static int borg_look_wanks[AUTO_MAX_Y];
+
+
+/*
+ * Hack -- grids to look at again on the next map update
+ */
+
+static bool borg_map_full = TRUE;
+
+static int borg_map_dirty_n = 0;
+static byte borg_map_dirty_x[AUTO_VIEW_MAX];
+static byte borg_map_dirty_y[AUTO_VIEW_MAX];
+static bool borg_map_dirty[AUTO_MAX_Y][AUTO_MAX_X];
+
+/* Panel and track list sizes as of the last map update */
+static int borg_map_w_x = -1;
+static int borg_map_w_y = -1;
+static int borg_map_track[5];
+
+
 
 
 /*
@@ -490,6 +529,7 @@ static int borg_new_take(struct object_kind *kind, int y, int x)
 	}
 	/* Hack -- Force the object to sit on a floor grid */
 	ag->feat = FEAT_FLOOR;
+	borg_relook_grid(y, x);
 
     /* Result */
     return (n);
@@ -610,6 +650,7 @@ static bool observe_take_move(int y, int x, int d, byte a, wchar_t c)
 
 		/* Mark floor underneath */
 		borg_grids[take->y][take->x].feat = FEAT_FLOOR;
+		borg_relook_grid(take->y, take->x);
 
         /* Done */
         return (TRUE);
@@ -1443,6 +1484,7 @@ static void borg_update_kill_new(int i)
     if (!rf_has(r_ptr->flags, RF_PASS_WALL))
     {
 		borg_grids[kill->y][kill->x].feat = FEAT_FLOOR;
+		borg_relook_grid(kill->y, kill->x);
 	}
 
 	/* Hack -- Force the ghostly monster to be in a wall
@@ -1451,6 +1493,7 @@ static void borg_update_kill_new(int i)
     if (borg_grids[kill->y][kill->x].feat == FEAT_NONE && rf_has(r_ptr->flags, RF_PASS_WALL))
     {
 		borg_grids[kill->y][kill->x].feat = FEAT_WALL_EXTRA;
+		borg_relook_grid(kill->y, kill->x);
 	}
 
 }
@@ -1603,6 +1646,7 @@ static void borg_update_kill_old(int i)
 	if (!rf_has(r_ptr->flags, RF_PASS_WALL))
 	{
 		borg_grids[kill->y][kill->x].feat = FEAT_FLOOR;
+		borg_relook_grid(kill->y, kill->x);
 	}
 
 	/* Hack -- Force the ghostly monster to be in a wall
@@ -1611,6 +1655,7 @@ static void borg_update_kill_old(int i)
 	if (borg_grids[kill->y][kill->x].feat == FEAT_NONE && rf_has(r_ptr->flags, RF_PASS_WALL))
 	{
 		borg_grids[kill->y][kill->x].feat = FEAT_WALL_EXTRA;
+		borg_relook_grid(kill->y, kill->x);
 	}
 
 	/* How far away from the player and can the player see the monster */
@@ -1649,6 +1694,9 @@ static void borg_update_kill_old(int i)
 
 	/* Update the grids */
     borg_grids[kill->y][kill->x].kill = i;
+
+    /* Recalculate danger */
+    borg_danger_forget(kill->y, kill->x);
 }
 
 
@@ -1677,6 +1725,9 @@ void borg_delete_kill(int i)
     if (rf_has(r_info[kill->r_idx].flags, RF_MULTIPLY))
         when_last_kill_mult = borg_t;
 
+    /* Recalculate danger */
+    borg_danger_forget(kill->y, kill->x);
+
     /* Kill the monster */
     WIPE(kill, borg_kill);
 
@@ -1713,6 +1764,7 @@ static void borg_sleep_kill(int i)
 
 	/* Recalculate danger */
     borg_danger_wipe = TRUE;
+    borg_danger_forget(kill->y, kill->x);
 }
 
 
@@ -1956,6 +2008,7 @@ static void borg_follow_kill(int i)
 
     /* Update the grids */
     borg_grids[kill->y][kill->x].kill = 0;
+    borg_danger_forget(kill->y, kill->x);
 
     /* Save the old Location */
     kill->ox = ox;
@@ -1967,6 +2020,7 @@ static void borg_follow_kill(int i)
 
     /* Update the grids */
     borg_grids[kill->y][kill->x].kill = i;
+    borg_danger_forget(kill->y, kill->x);
 
     /* Note */
     borg_note(format("# Following a monster '%s' to (%d,%d) from (%d,%d)",
@@ -2043,6 +2097,7 @@ static int borg_new_kill(int r_idx, int y, int x)
 
     /* Update the grids */
     borg_grids[kill->y][kill->x].kill = n;
+    borg_danger_forget(kill->y, kill->x);
 
     /* Timestamp */
     kill->when = borg_t;
@@ -2112,6 +2167,7 @@ static int borg_new_kill(int r_idx, int y, int x)
     if (ag->feat == FEAT_NONE && !(rf_has(r_ptr->flags, RF_PASS_WALL)))
     {
 		ag->feat = FEAT_FLOOR;
+		borg_relook_grid(y, x);
 	}
 
 	/* Hack -- Force the ghostly monster to be in a wall
@@ -2120,6 +2176,7 @@ static int borg_new_kill(int r_idx, int y, int x)
     if (ag->feat == FEAT_NONE && rf_has(r_ptr->flags, RF_PASS_WALL))
     {
 		ag->feat = FEAT_WALL_EXTRA;
+		borg_relook_grid(y, x);
 	}
 
 	/* Count up out list of Nasties */
@@ -2279,6 +2336,7 @@ static bool observe_kill_move(int y, int x, int d, byte a, wchar_t c, bool flag)
 
             /* Update the grids */
             borg_grids[kill->y][kill->x].kill = 0;
+            borg_danger_forget(kill->y, kill->x);
 
             /* Save the old Location */
             kill->ox = kill->x;
@@ -2290,6 +2348,7 @@ static bool observe_kill_move(int y, int x, int d, byte a, wchar_t c, bool flag)
 
             /* Update the grids */
             borg_grids[kill->y][kill->x].kill = i;
+            borg_danger_forget(kill->y, kill->x);
 
             /* Note */
             if (borg_verbose) borg_note(format("# Tracking a monster '%s' from (%d,%d) to (%d,%d)",
@@ -3069,6 +3128,7 @@ static int borg_locate_kill(char *who, int y, int x, int r)
 
         /* Change the race */
         kill->r_idx = r_idx;
+        borg_danger_forget(kill->y, kill->x);
 
         /* Known identity */
         if (!r) kill->known = TRUE;
@@ -3530,12 +3590,60 @@ static void borg_forget_map(void)
 
     /* Forget the view */
     borg_forget_view();
+
+    /* Forget the looks */
+    WIPE(borg_looks, borg_looks);
+    WIPE(borg_look_wanks, borg_look_wanks);
+
+    /* Look at the whole panel */
+    borg_map_full = TRUE;
+}
+
+
+/*
+ * Look at a grid again on the next map update, because the game has
+ * redrawn it, or because the Borg has been guessing about it.
+ */
+void borg_relook_grid(int y, int x)
+{
+    /* Already noted */
+    if (borg_map_full || borg_map_dirty[y][x]) return;
+
+    /* Too many to track, look at the whole panel */
+    if (borg_map_dirty_n == AUTO_VIEW_MAX)
+    {
+        borg_map_full = TRUE;
+        return;
+    }
+
+    /* Track the grid */
+    borg_map_dirty[y][x] = TRUE;
+    borg_map_dirty_x[borg_map_dirty_n] = x;
+    borg_map_dirty_y[borg_map_dirty_n] = y;
+    borg_map_dirty_n++;
+}
+
+
+/*
+ * Note a grid which the game has redrawn.  A redraw of the whole map
+ * is sent as (-1,-1).
+ */
+static void borg_map_redraw(game_event_type type, game_event_data *data, void *user)
+{
+    /* Whole map */
+    if (data->point.x < 0 || data->point.y < 0)
+    {
+        borg_map_full = TRUE;
+        return;
+    }
+
+    borg_relook_grid(data->point.y, data->point.x);
 }
 
 static byte Get_f_info_number[256];
 
 /*
- * Update the "map" based on visual info on the screen
+ * Update a grid of the "map" based on visual info on the screen
  *
  * Note that we make assumptions about the grid under the player,
  * to prevent painful situations such as seeming to be standing
@@ -3623,533 +3731,677 @@ static byte Get_f_info_number[256];
  * remove it from any "flow" which might be in progress, to prevent
  * nasty situations in which we attempt to flow into a wall grid
  * which was thought to be something else, like an unknown grid.
- *
  */
-static void borg_update_map(void)
+static void borg_update_map_grid(int y, int x)
 {
-    int i, x, y, dx, dy;
+    int i;
+
+    bool old_wall;
+    bool new_wall;
+    bool had_wank;
 
     borg_grid *ag;
-	grid_data g;
+    borg_look *look;
+    grid_data g;
 
-    /* Analyze the current map panel */
-    for (dy = 0; dy < SCREEN_HGT; dy++)
+	/* Cheat the exact information from the screen */
+	map_info(y, x, &g);
+
+    /* Get the borg_grid */
+    ag = &borg_grids[y][x];
+    look = &borg_looks[y][x];
+
+    /* Notice "on-screen" */
+    ag->info |= BORG_OKAY;
+
+	/* Notice "knowledge" */
+    if (g.f_idx != FEAT_NONE)
     {
-        /* Scan the row */
-        for (dx = 0; dx < SCREEN_WID; dx++)
-        {
-            bool old_wall;
-            bool new_wall;
+        ag->info |= BORG_MARK;
+		/* Assume its the f_idx unless we know otherwise */
+        if (ag->feat == FEAT_NONE) ag->feat = g.f_idx;
+    }
 
+    /* Notice the player */
+    if (g.is_player)
+    {
+        /* Memorize player location */
+        c_x = x;
+        c_y = y;
+    }
 
-            /* Obtain the map location */
-            x = w_x + dx;
-            y = w_y + dy;
+    /* Save the old "wall" or "door" */
+    old_wall = !borg_cave_floor_grid(ag);
 
-			/* Cheat the exact information from the screen */
-			map_info(y, x, &g);
+    /* Analyze symbol */
+    switch (g.f_idx)
+    {
+        /* Darkness */
+        case FEAT_NONE:
+        {
+            /* The grid is not lit */
+            ag->info &= ~BORG_GLOW;
 
-            /* Get the borg_grid */
-            ag = &borg_grids[y][x];
+            /* Known grids must be dark floors */
+            if (ag->feat != FEAT_NONE) ag->info |= BORG_DARK;
 
-            /* Notice "on-screen" */
-            ag->info |= BORG_OKAY;
+            /* Done */
+            break;
+        }
 
-			/* Notice "knowledge" */
-            if (g.f_idx != FEAT_NONE)
+        /* Floors */
+        case FEAT_FLOOR:
+        {
+            byte info = cave->info[y][x];
+
+			/* Handle "blind" */
+            if (borg_skill[BI_ISBLIND])
             {
-                ag->info |= BORG_MARK;
-				/* Assume its the f_idx unless we know otherwise */
-                if (ag->feat == FEAT_NONE) ag->feat = g.f_idx;
+                /* Nothing */
             }
 
-            /* Notice the player */
-            if (g.is_player)
+			/* Handle "dark" floors */
+            if (g.lighting == FEAT_LIGHTING_DARK)
             {
-                /* Memorize player location */
-                c_x = x;
-                c_y = y;
+                /* Dark floor grid */
+                ag->info |= BORG_DARK;
+                ag->info &= ~BORG_GLOW;
             }
 
-            /* Save the old "wall" or "door" */
-            old_wall = !borg_cave_floor_grid(ag);
+			/* Handle Glowing floors */
+            else if (g.lighting == FEAT_LIGHTING_BRIGHT ||
+					 g.lighting == FEAT_LIGHTING_LIT)
+			{
+					/* Perma Glowing Grid */
+					if (cave->info[y][x] & CAVE_GLOW) ag->info |= BORG_GLOW;
 
-            /* Analyze symbol */
-            switch (g.f_idx)
-            {
-                /* Darkness */
-                case FEAT_NONE:
-                {
-                    /* The grid is not lit */
-                    ag->info &= ~BORG_GLOW;
+					/* Assume not dark */
+					ag->info &= ~BORG_DARK;
+			}
 
-                    /* Known grids must be dark floors */
-                    if (ag->feat != FEAT_NONE) ag->info |= BORG_DARK;
+			/* torch-lit grids */
+	        ag->info |= BORG_LIGHT;
 
-                    /* Done */
-                    break;
-                }
+			/* Assume not dark */
+			ag->info &= ~BORG_DARK;
 
-                /* Floors */
-                case FEAT_FLOOR:
-                {
-                    byte info = cave->info[y][x];
-
-					/* Handle "blind" */
-                    if (borg_skill[BI_ISBLIND])
-                    {
-                        /* Nothing */
-                    }
-
-					/* Handle "dark" floors */
-                    if (g.lighting == FEAT_LIGHTING_DARK)
-                    {
-                        /* Dark floor grid */
-                        ag->info |= BORG_DARK;
-                        ag->info &= ~BORG_GLOW;
-                    }
-
-					/* Handle Glowing floors */
-                    else if (g.lighting == FEAT_LIGHTING_BRIGHT ||
-							 g.lighting == FEAT_LIGHTING_LIT)
-					{
-							/* Perma Glowing Grid */
-							if (cave->info[y][x] & CAVE_GLOW) ag->info |= BORG_GLOW;
+            /* Known floor */
+            ag->feat = FEAT_FLOOR;
 
-							/* Assume not dark */
-							ag->info &= ~BORG_DARK;
-					}
+            /* Done */
+            break;
+        }
 
-					/* torch-lit grids */
-			        ag->info |= BORG_LIGHT;
+        /* Open doors */
+        case FEAT_OPEN:
+        case FEAT_BROKEN:
+        {
+            /* The borg cannot distinguish at a glance which is
+               which so the actual cave->feat is plugged in */
+            byte feat = cave->feat[y][x];
 
-					/* Assume not dark */
-					ag->info &= ~BORG_DARK;
+            /* Accept broken */
+            if (ag->feat == FEAT_BROKEN) break;
 
-                    /* Known floor */
-                    ag->feat = FEAT_FLOOR;
+            /* Hack- cheat the broken into memory */
+            if (feat == FEAT_BROKEN)
+            {
+                ag->feat = FEAT_BROKEN;
+                break;
+            }
 
-                    /* Done */
-                    break;
-                }
+            /* Assume normal */
+            ag->feat = FEAT_OPEN;
 
-                /* Open doors */
-                case FEAT_OPEN:
-                case FEAT_BROKEN:
-                {
-                    /* The borg cannot distinguish at a glance which is
-                       which so the actual cave->feat is plugged in */
-                    byte feat = cave->feat[y][x];
+            /* Done */
+            break;
+        }
 
-                    /* Accept broken */
-                    if (ag->feat == FEAT_BROKEN) break;
+        /* Walls */
+        case FEAT_WALL_EXTRA:
+        case FEAT_WALL_INNER:
+        case FEAT_WALL_OUTER:
+        case FEAT_WALL_SOLID:
+        case FEAT_PERM_SOLID:
+        case FEAT_PERM_EXTRA:
+        case FEAT_PERM_INNER:
+        case FEAT_PERM_OUTER:
+        {
+            /* ok this is a humongo cheat.  He is pulling the
+             * grid information from the game rather than from
+             * his memory.  He is going to see if the wall is perm.
+             * This is a cheat. May the Lord have mercy on my soul.
+             *
+             * The only other option is to have him "dig" on each
+             * and every granite wall to see if it is perm.  Then he
+             * can mark it as a non-perm.  However, he would only have
+             * to dig once and only in a range of spaces near the
+             * center of the map.  Since perma-walls are located in
+             * vaults and vaults have a minimum size.  So he can avoid
+             * digging on walls that are, say, 10 spaces from the edge
+             * of the map.  He can also limit the dig by his depth.
+             * Vaults are found below certain levels and with certain
+             * "feelings."  Can be told not to dig on boring levels
+             * and not before level 50 or whatever.
+             *
+             * Since the code to dig slows the borg down a lot.
+             * (Found in borg6.c in _flow_dark_interesting()) We will
+             * limit his capacity to search.  We will set a flag on
+             * the level is perma grids are found.
+             */
+            byte feat = cave->feat[y][x];
+
+            /* is it a perma grid? */
+            if (feat == FEAT_PERM_INNER)
+            {
+                ag->feat = FEAT_PERM_INNER;
+                borg_depth |= DEPTH_VAULT;
+                break;
+            }
 
-                    /* Hack- cheat the broken into memory */
-                    if (feat == FEAT_BROKEN)
-                    {
-                        ag->feat = FEAT_BROKEN;
-                        break;
-                    }
+			/* is it a perma grid? from a maze/ labyrinth ? */
+            if (feat == FEAT_PERM_SOLID && (y >= 3 && y < AUTO_MAX_Y && x >= 3 && x <= AUTO_MAX_X))
+            {
+                ag->feat = FEAT_PERM_SOLID;
+                borg_depth |= DEPTH_LABYRINTH;
+                break;
+            }
 
-                    /* Assume normal */
-                    ag->feat = FEAT_OPEN;
+			/* forget previously located walls */
+            if (ag->feat == FEAT_PERM_INNER) break;
 
-                    /* Done */
-                    break;
-                }
+            /* is it a non perma grid? */
+            if (feat >= FEAT_PERM_EXTRA)
+            {
+                ag->feat = FEAT_PERM_SOLID;
+                break;
+            }
 
-                /* Walls */
-                case FEAT_WALL_EXTRA:
-                case FEAT_WALL_INNER:
-                case FEAT_WALL_OUTER:
-                case FEAT_WALL_SOLID:
-                case FEAT_PERM_SOLID:
-                case FEAT_PERM_EXTRA:
-                case FEAT_PERM_INNER:
-                case FEAT_PERM_OUTER:
-                {
-                    /* ok this is a humongo cheat.  He is pulling the
-                     * grid information from the game rather than from
-                     * his memory.  He is going to see if the wall is perm.
-                     * This is a cheat. May the Lord have mercy on my soul.
-                     *
-                     * The only other option is to have him "dig" on each
-                     * and every granite wall to see if it is perm.  Then he
-                     * can mark it as a non-perm.  However, he would only have
-                     * to dig once and only in a range of spaces near the
-                     * center of the map.  Since perma-walls are located in
-                     * vaults and vaults have a minimum size.  So he can avoid
-                     * digging on walls that are, say, 10 spaces from the edge
-                     * of the map.  He can also limit the dig by his depth.
-                     * Vaults are found below certain levels and with certain
-                     * "feelings."  Can be told not to dig on boring levels
-                     * and not before level 50 or whatever.
-                     *
-                     * Since the code to dig slows the borg down a lot.
-                     * (Found in borg6.c in _flow_dark_interesting()) We will
-                     * limit his capacity to search.  We will set a flag on
-                     * the level is perma grids are found.
-                     */
-                    byte feat = cave->feat[y][x];
-
-                    /* is it a perma grid? */
-                    if (feat == FEAT_PERM_INNER)
-                    {
-                        ag->feat = FEAT_PERM_INNER;
-                        borg_depth |= DEPTH_VAULT;
-                        break;
-                    }
-
-					/* is it a perma grid? from a maze/ labyrinth ? */
-                    if (feat == FEAT_PERM_SOLID && (y >= 3 && y < AUTO_MAX_Y && x >= 3 && x <= AUTO_MAX_X))
-                    {
-                        ag->feat = FEAT_PERM_SOLID;
-                        borg_depth |= DEPTH_LABYRINTH;
-                        break;
-                    }
-
-					/* forget previously located walls */
-                    if (ag->feat == FEAT_PERM_INNER) break;
-
-                    /* is it a non perma grid? */
-                    if (feat >= FEAT_PERM_EXTRA)
-                    {
-                        ag->feat = FEAT_PERM_SOLID;
-                        break;
-                    }
-
-					/* Accept non-granite */
-                    if (ag->feat >= FEAT_WALL_EXTRA &&
-                        ag->feat <= FEAT_PERM_EXTRA) break;
-
-                    /* Assume granite */
-                    ag->feat = FEAT_WALL_EXTRA;
-
-                    /* Done */
-                    break;
-                }
+			/* Accept non-granite */
+            if (ag->feat >= FEAT_WALL_EXTRA &&
+                ag->feat <= FEAT_PERM_EXTRA) break;
 
-                /* Seams */
-                case FEAT_MAGMA:
-                case FEAT_QUARTZ:
-				{
-                    /* Accept quartz */
-                    if (ag->feat == FEAT_QUARTZ) break;
+            /* Assume granite */
+            ag->feat = FEAT_WALL_EXTRA;
 
-                    /* Assume magma */
-                    ag->feat = FEAT_MAGMA;
+            /* Done */
+            break;
+        }
 
-                    /* Done */
-                    break;
-                }
+        /* Seams */
+        case FEAT_MAGMA:
+        case FEAT_QUARTZ:
+		{
+            /* Accept quartz */
+            if (ag->feat == FEAT_QUARTZ) break;
 
-                /* Hidden */
-                case FEAT_MAGMA_K:
-                case FEAT_QUARTZ_K:
-                {
-                	/* Check for an existing vein */
-                	for (i = 0; i < track_vein_num; i++)
-                	{
-                	    /* Stop if we already new about this */
-                	    if ((track_vein_x[i] == x) && (track_vein_y[i] == y)) break;
-                	}
-
-                	/* Track the newly discovered vein */
-                	if ((i == track_vein_num) && (i < track_vein_size))
-                	{
-                	    track_vein_x[i] = x;
-                	    track_vein_y[i] = y;
-                	    track_vein_num++;
-
-						/* do not overflow */
-						if (track_vein_num > 99) track_vein_num = 99;
-					}
+            /* Assume magma */
+            ag->feat = FEAT_MAGMA;
 
-					/* Accept quartz */
-                    if (ag->feat == FEAT_QUARTZ_K) break;
+            /* Done */
+            break;
+        }
 
-                    /* Assume magma */
-                    ag->feat = FEAT_MAGMA_K;
+        /* Hidden */
+        case FEAT_MAGMA_K:
+        case FEAT_QUARTZ_K:
+        {
+        	/* Check for an existing vein */
+        	for (i = 0; i < track_vein_num; i++)
+        	{
+        	    /* Stop if we already new about this */
+        	    if ((track_vein_x[i] == x) && (track_vein_y[i] == y)) break;
+        	}
 
-                    /* Done */
-                    break;
-                }
+        	/* Track the newly discovered vein */
+        	if ((i == track_vein_num) && (i < track_vein_size))
+        	{
+        	    track_vein_x[i] = x;
+        	    track_vein_y[i] = y;
+        	    track_vein_num++;
 
-                /* Rubble */
-                case FEAT_RUBBLE:
-                {
-                    /* Assume rubble */
-                    ag->feat = FEAT_RUBBLE;
+				/* do not overflow */
+				if (track_vein_num > 99) track_vein_num = 99;
+			}
 
-                    /* Done */
-                    break;
-                }
+			/* Accept quartz */
+            if (ag->feat == FEAT_QUARTZ_K) break;
 
-                /* Doors */
-                case FEAT_DOOR_HEAD:
-                case FEAT_DOOR_HEAD+1:
-                case FEAT_DOOR_HEAD+2:
-                case FEAT_DOOR_HEAD+3:
-                case FEAT_DOOR_HEAD+4:
-                case FEAT_DOOR_HEAD+5:
-                case FEAT_DOOR_HEAD+6:
-                case FEAT_DOOR_HEAD+7:
-                case FEAT_DOOR_HEAD+8:
-                case FEAT_DOOR_HEAD+9:
-                case FEAT_DOOR_HEAD+10:
-                case FEAT_DOOR_HEAD+11:
-                case FEAT_DOOR_HEAD+12:
-                case FEAT_DOOR_HEAD+13:
-                case FEAT_DOOR_HEAD+14:
-                case FEAT_DOOR_TAIL:
-                {
-					/* Only while low level */
-					if (borg_skill[BI_CLEVEL] <= 5)
-					{
-                    	/* Check for an existing door */
-                    	for (i = 0; i < track_closed_num; i++)
-                    	{
-                    	    /* Stop if we already new about this door */
-                    	    if ((track_closed_x[i] == x) && (track_closed_y[i] == y)) break;
-                    	}
-
-                    	/* Track the newly discovered door */
-                    	if ((i == track_closed_num) && (i < track_closed_size))
-                    	{
-                    	    track_closed_x[i] = x;
-                    	    track_closed_y[i] = y;
-                    	    track_closed_num++;
-
-							/* do not overflow */
-							if (track_closed_num > 254) track_closed_num = 254;
-						}
-					}
+            /* Assume magma */
+            ag->feat = FEAT_MAGMA_K;
 
-                  	/* Accept jammed ones defined in borg9.c*/
-                    if ((ag->feat >= FEAT_DOOR_JAMMED) && (ag->feat <= FEAT_DOOR_TAIL)) break;
+            /* Done */
+            break;
+        }
 
-                    /* Accept closed and locked */
-                    if ((ag->feat >= FEAT_DOOR_HEAD) && (ag->feat <= FEAT_DOOR_HEAD + 0x07)) break;
+        /* Rubble */
+        case FEAT_RUBBLE:
+        {
+            /* Assume rubble */
+            ag->feat = FEAT_RUBBLE;
 
-					/* Assume easy until we learn its Jammed */
-                   	ag->feat = FEAT_DOOR_HEAD + 0x00;
+            /* Done */
+            break;
+        }
 
-                    /* Done */
-                    break;
-                }
+        /* Doors */
+        case FEAT_DOOR_HEAD:
+        case FEAT_DOOR_HEAD+1:
+        case FEAT_DOOR_HEAD+2:
+        case FEAT_DOOR_HEAD+3:
+        case FEAT_DOOR_HEAD+4:
+        case FEAT_DOOR_HEAD+5:
+        case FEAT_DOOR_HEAD+6:
+        case FEAT_DOOR_HEAD+7:
+        case FEAT_DOOR_HEAD+8:
+        case FEAT_DOOR_HEAD+9:
+        case FEAT_DOOR_HEAD+10:
+        case FEAT_DOOR_HEAD+11:
+        case FEAT_DOOR_HEAD+12:
+        case FEAT_DOOR_HEAD+13:
+        case FEAT_DOOR_HEAD+14:
+        case FEAT_DOOR_TAIL:
+        {
+			/* Only while low level */
+			if (borg_skill[BI_CLEVEL] <= 5)
+			{
+            	/* Check for an existing door */
+            	for (i = 0; i < track_closed_num; i++)
+            	{
+            	    /* Stop if we already new about this door */
+            	    if ((track_closed_x[i] == x) && (track_closed_y[i] == y)) break;
+            	}
+
+            	/* Track the newly discovered door */
+            	if ((i == track_closed_num) && (i < track_closed_size))
+            	{
+            	    track_closed_x[i] = x;
+            	    track_closed_y[i] = y;
+            	    track_closed_num++;
+
+					/* do not overflow */
+					if (track_closed_num > 254) track_closed_num = 254;
+				}
+			}
 
-                /* Traps */
-                case FEAT_TRAP_HEAD:
-                case FEAT_TRAP_HEAD+1:
-                case FEAT_TRAP_HEAD+2:
-                case FEAT_TRAP_HEAD+3:
-                case FEAT_TRAP_HEAD+4:
-                case FEAT_TRAP_HEAD+5:
-                case FEAT_TRAP_HEAD+6:
-                case FEAT_TRAP_HEAD+7:
-                case FEAT_TRAP_HEAD+8:
-                case FEAT_TRAP_HEAD+9:
-                case FEAT_TRAP_HEAD+10:
-                case FEAT_TRAP_HEAD+11:
-                case FEAT_TRAP_HEAD+12:
-                case FEAT_TRAP_HEAD+13:
-                case FEAT_TRAP_HEAD+14:
-                case FEAT_TRAP_TAIL:
-                {
+          	/* Accept jammed ones defined in borg9.c*/
+            if ((ag->feat >= FEAT_DOOR_JAMMED) && (ag->feat <= FEAT_DOOR_TAIL)) break;
 
-                    /* Minor cheat for the borg.  If the borg is running
-                     * in the graphics mode (not the AdamBolt Tiles) he will
-                     * mis-id the glyph of warding as a trap
-                     */
-                    byte feat = cave->feat[y][x];
-                    if (feat == FEAT_GLYPH)
-                    {
-                        ag->feat = FEAT_GLYPH;
-                        /* Check for an existing glyph */
-                        for (i = 0; i < track_glyph_num; i++)
-                        {
-                            /* Stop if we already new about this glyph */
-                            if ((track_glyph_x[i] == x) && (track_glyph_y[i] == y)) break;
-                        }
-
-                        /* Track the newly discovered glyph */
-                        if ((i == track_glyph_num) && (i < track_glyph_size))
-                        {
-                            track_glyph_x[i] = x;
-                            track_glyph_y[i] = y;
-                            track_glyph_num++;
-                        }
-
-                        /* done */
-                        break;
-                    }
-
-                    /* Assume trap door */
-                    ag->feat = FEAT_TRAP_HEAD + 0x00;
-
-                    /* Done */
-                    break;
-                }
+            /* Accept closed and locked */
+            if ((ag->feat >= FEAT_DOOR_HEAD) && (ag->feat <= FEAT_DOOR_HEAD + 0x07)) break;
 
-                /* glyph of warding stuff here,  */
-                case FEAT_GLYPH:
-                {
-                    ag->feat = FEAT_GLYPH;
-
-                    /* Check for an existing glyph */
-                    for (i = 0; i < track_glyph_num; i++)
-                    {
-                        /* Stop if we already new about this glyph */
-                        if ((track_glyph_x[i] == x) && (track_glyph_y[i] == y)) break;
-                    }
-
-                    /* Track the newly discovered glyph */
-                    if ((i == track_glyph_num) && (i < track_glyph_size))
-                    {
-                        track_glyph_x[i] = x;
-                        track_glyph_y[i] = y;
-                        track_glyph_num++;
-                    }
-
-                    /* done */
-                    break;
-                }
+			/* Assume easy until we learn its Jammed */
+           	ag->feat = FEAT_DOOR_HEAD + 0x00;
+
+            /* Done */
+            break;
+        }
 
-                /* Up stairs */
-                case FEAT_LESS:
+        /* Traps */
+        case FEAT_TRAP_HEAD:
+        case FEAT_TRAP_HEAD+1:
+        case FEAT_TRAP_HEAD+2:
+        case FEAT_TRAP_HEAD+3:
+        case FEAT_TRAP_HEAD+4:
+        case FEAT_TRAP_HEAD+5:
+        case FEAT_TRAP_HEAD+6:
+        case FEAT_TRAP_HEAD+7:
+        case FEAT_TRAP_HEAD+8:
+        case FEAT_TRAP_HEAD+9:
+        case FEAT_TRAP_HEAD+10:
+        case FEAT_TRAP_HEAD+11:
+        case FEAT_TRAP_HEAD+12:
+        case FEAT_TRAP_HEAD+13:
+        case FEAT_TRAP_HEAD+14:
+        case FEAT_TRAP_TAIL:
+        {
+
+            /* Minor cheat for the borg.  If the borg is running
+             * in the graphics mode (not the AdamBolt Tiles) he will
+             * mis-id the glyph of warding as a trap
+             */
+            byte feat = cave->feat[y][x];
+            if (feat == FEAT_GLYPH)
+            {
+                ag->feat = FEAT_GLYPH;
+                /* Check for an existing glyph */
+                for (i = 0; i < track_glyph_num; i++)
                 {
-                    /* Obvious */
-                    ag->feat = FEAT_LESS;
-
-                    /* Check for an existing "up stairs" */
-                    for (i = 0; i < track_less_num; i++)
-                    {
-                        /* Stop if we already new about these stairs */
-                        if ((track_less_x[i] == x) && (track_less_y[i] == y)) break;
-                    }
-
-                    /* Track the newly discovered "up stairs" */
-                    if ((i == track_less_num) && (i < track_less_size))
-                    {
-                        track_less_x[i] = x;
-                        track_less_y[i] = y;
-                        track_less_num++;
-                    }
-                    /* Done */
-                    break;
+                    /* Stop if we already new about this glyph */
+                    if ((track_glyph_x[i] == x) && (track_glyph_y[i] == y)) break;
                 }
 
-                /* Down stairs */
-                case FEAT_MORE:
+                /* Track the newly discovered glyph */
+                if ((i == track_glyph_num) && (i < track_glyph_size))
                 {
-                    /* Obvious */
-                    ag->feat = FEAT_MORE;
-
-                    /* Check for an existing "down stairs" */
-                    for (i = 0; i < track_more_num; i++)
-                    {
-                        /* We already knew about that one */
-                        if ((track_more_x[i] == x) && (track_more_y[i] == y)) break;
-
-                    }
-
-                    /* Track the newly discovered "down stairs" */
-                    if ((i == track_more_num) && (i < track_more_size))
-                    {
-                        track_more_x[i] = x;
-                        track_more_y[i] = y;
-                        track_more_num++;
-                    }
-
-                    /* Done */
-                    break;
+                    track_glyph_x[i] = x;
+                    track_glyph_y[i] = y;
+                    track_glyph_num++;
                 }
 
-                /* Store doors */
-                case FEAT_SHOP_HEAD:
-                case FEAT_SHOP_HEAD+1:
-                case FEAT_SHOP_HEAD+2:
-                case FEAT_SHOP_HEAD+3:
-                case FEAT_SHOP_HEAD+4:
-                case FEAT_SHOP_HEAD+5:
-                case FEAT_SHOP_HEAD+6:
-                case FEAT_SHOP_TAIL:
+                /* done */
+                break;
+            }
 
-                {
-                    /* Shop type */
-                    ag->feat = g.f_idx;
-					i = ag->feat - FEAT_SHOP_HEAD;
-					
+            /* Assume trap door */
+            ag->feat = FEAT_TRAP_HEAD + 0x00;
 
-                    /* Save new information */
-                    track_shop_x[i] = x;
-                    track_shop_y[i] = y;
+            /* Done */
+            break;
+        }
 
-                    /* Done */
-                    break;
-                }
-			}
+        /* glyph of warding stuff here,  */
+        case FEAT_GLYPH:
+        {
+            ag->feat = FEAT_GLYPH;
 
-            /* Now do non-feature stuff */
-            if (g.first_kind || g.m_idx)
+            /* Check for an existing glyph */
+            for (i = 0; i < track_glyph_num; i++)
             {
-				/* Monsters/Objects */
-				borg_wank *wank;
+                /* Stop if we already new about this glyph */
+                if ((track_glyph_x[i] == x) && (track_glyph_y[i] == y)) break;
+            }
 
-				 /* Check for memory overflow */
-				if (borg_wank_num == AUTO_VIEW_MAX)
-				{
-					borg_note(format("# Wank problem at grid (%d,%d) m:%d o:%d, borg at (%d,%d)",
-					                 y, x, g.m_idx, g.first_kind ? g.first_kind->kidx : 0, c_y, c_x));
-					borg_oops("too many objects...");
-				}
+            /* Track the newly discovered glyph */
+            if ((i == track_glyph_num) && (i < track_glyph_size))
+            {
+                track_glyph_x[i] = x;
+                track_glyph_y[i] = y;
+                track_glyph_num++;
+            }
 
-				/* Access next wank, advance */
-				wank = &borg_wanks[borg_wank_num++];
+            /* done */
+            break;
+        }
 
-				/* Save some information */
-				wank->x = x;
-				wank->y = y;
-				/* monster symbol takes priority */
-				/* TODO: Store known information about monster/object, instead
-				 * of just the screen character */
-				if (g.m_idx)
-				{
-					monster_type *m_ptr = cave_monster(cave, g.m_idx);
-					wank->t_a = m_ptr->attr;
-					wank->t_c = r_info[m_ptr->r_idx].d_char;
-					wank->is_kill = TRUE;
-				}
-				else
-				{
-					wank->t_a = g.first_kind->d_attr;
-					wank->t_c = g.first_kind->d_char;
-					wank->is_take = TRUE;
-				}
+        /* Up stairs */
+        case FEAT_LESS:
+        {
+            /* Obvious */
+            ag->feat = FEAT_LESS;
+
+            /* Check for an existing "up stairs" */
+            for (i = 0; i < track_less_num; i++)
+            {
+                /* Stop if we already new about these stairs */
+                if ((track_less_x[i] == x) && (track_less_y[i] == y)) break;
+            }
+
+            /* Track the newly discovered "up stairs" */
+            if ((i == track_less_num) && (i < track_less_size))
+            {
+                track_less_x[i] = x;
+                track_less_y[i] = y;
+                track_less_num++;
+            }
+            /* Done */
+            break;
+        }
+
+        /* Down stairs */
+        case FEAT_MORE:
+        {
+            /* Obvious */
+            ag->feat = FEAT_MORE;
+
+            /* Check for an existing "down stairs" */
+            for (i = 0; i < track_more_num; i++)
+            {
+                /* We already knew about that one */
+                if ((track_more_x[i] == x) && (track_more_y[i] == y)) break;
+
+            }
+
+            /* Track the newly discovered "down stairs" */
+            if ((i == track_more_num) && (i < track_more_size))
+            {
+                track_more_x[i] = x;
+                track_more_y[i] = y;
+                track_more_num++;
+            }
+
+            /* Done */
+            break;
+        }
+
+        /* Store doors */
+        case FEAT_SHOP_HEAD:
+        case FEAT_SHOP_HEAD+1:
+        case FEAT_SHOP_HEAD+2:
+        case FEAT_SHOP_HEAD+3:
+        case FEAT_SHOP_HEAD+4:
+        case FEAT_SHOP_HEAD+5:
+        case FEAT_SHOP_HEAD+6:
+        case FEAT_SHOP_TAIL:
+
+        {
+            /* Shop type */
+            ag->feat = g.f_idx;
+			i = ag->feat - FEAT_SHOP_HEAD;
+			
+
+            /* Save new information */
+            track_shop_x[i] = x;
+            track_shop_y[i] = y;
+
+            /* Done */
+            break;
+        }
+	}
+
+    /* Now do non-feature stuff */
+    had_wank = (look->is_take || look->is_kill);
+    look->is_take = look->is_kill = FALSE;
+    if (g.first_kind || g.m_idx)
+    {
+        /* monster symbol takes priority */
+        /* TODO: Store known information about monster/object, instead
+         * of just the screen character */
+        if (g.m_idx)
+        {
+            monster_type *m_ptr = cave_monster(cave, g.m_idx);
+            look->t_a = m_ptr->attr;
+            look->t_c = r_info[m_ptr->r_idx].d_char;
+            look->is_kill = TRUE;
+        }
+        else
+        {
+            look->t_a = g.first_kind->d_attr;
+            look->t_c = g.first_kind->d_char;
+            look->is_take = TRUE;
+        }
+    }
+
+    /* Count the wanks in the row */
+    if (had_wank && !look->is_take && !look->is_kill) borg_look_wanks[y]--;
+    if (!had_wank && (look->is_take || look->is_kill)) borg_look_wanks[y]++;
+
+    /* Save the new "wall" or "door" */
+    new_wall = !borg_cave_floor_grid(ag);
+
+    /* Notice wall changes */
+    if (old_wall != new_wall)
+    {
+        /* Remove this grid from any flow */
+        if (new_wall) borg_data_flow->data[y][x] = 255;
+
+        /* Remove this grid from any flow */
+        borg_data_know->data[y][x] = FALSE;
+
+        /* Remove this grid from any flow */
+        borg_data_icky->data[y][x] = FALSE;
+
+        /* Recalculate the view (if needed) */
+        if (ag->info & BORG_VIEW) borg_do_update_view = TRUE;
+
+        /* Recalculate the lite (if needed) */
+        if (ag->info & BORG_LIGHT) borg_do_update_light = TRUE;
+    }
+}
+
+
+
+/*
+ * Update the "map" based on visual info on the screen
+ *
+ * Only the grids noted by "borg_relook_grid()" since the last update
+ * are looked at again, unless the panel has changed, the whole map was
+ * redrawn, or some of the track lists have been cleared (so that they
+ * can be rebuilt).  The "wanks" are then rebuilt from the looks.
+ *
+ * Define BORG_CHECK_MAP to look at the whole panel again every hundred
+ * updates, and note any grid that the shortcut missed.
+ */
+static void borg_update_map(void)
+{
+    int i, x, y;
+
+    int hgt = SCREEN_HGT;
+    int wid = SCREEN_WID;
+
+    bool full = borg_map_full;
+
+    borg_look *look;
+
+#ifdef BORG_CHECK_MAP
+    static int checks = 0;
+#endif
+
+    /* New panel */
+    if ((w_x != borg_map_w_x) || (w_y != borg_map_w_y)) full = TRUE;
+
+    /* Cleared track lists */
+    if ((track_less_num < borg_map_track[0]) ||
+        (track_more_num < borg_map_track[1]) ||
+        (track_glyph_num < borg_map_track[2]) ||
+        (track_closed_num < borg_map_track[3]) ||
+        (track_vein_num < borg_map_track[4])) full = TRUE;
+
+    /* Analyze the current map panel */
+    if (full)
+    {
+        for (y = w_y; y < w_y + hgt; y++)
+        {
+            for (x = w_x; x < w_x + wid; x++)
+            {
+                borg_update_map_grid(y, x);
             }
+        }
+    }
 
-            /* Save the new "wall" or "door" */
-            new_wall = !borg_cave_floor_grid(ag);
+    /* Analyze the changed grids */
+    else
+    {
+        /* Grids the Borg may have guessed about, around the player */
+        borg_relook_grid(c_y, c_x);
+        for (i = 0; i < 8; i++)
+        {
+            borg_relook_grid(c_y + ddy_ddd[i], c_x + ddx_ddd[i]);
+        }
+
+        /* Grids the game has redrawn, or the Borg guessed about */
+        for (i = 0; i < borg_map_dirty_n; i++)
+        {
+            x = borg_map_dirty_x[i];
+            y = borg_map_dirty_y[i];
+
+            /* Skip grids off the panel */
+            if ((x < w_x) || (x >= w_x + wid)) continue;
+            if ((y < w_y) || (y >= w_y + hgt)) continue;
+
+            borg_update_map_grid(y, x);
+        }
 
-            /* Notice wall changes */
-            if (old_wall != new_wall)
+#ifdef BORG_CHECK_MAP
+        /* Every so often, check that nothing was missed */
+        if (!borg_skill[BI_ISIMAGE] && !(++checks % 100))
+        {
+            for (y = w_y; y < w_y + hgt; y++)
             {
-                /* Remove this grid from any flow */
-                if (new_wall) borg_data_flow->data[y][x] = 255;
+                for (x = w_x; x < w_x + wid; x++)
+                {
+                    borg_grid *ag = &borg_grids[y][x];
+                    borg_look old;
+                    byte feat, info;
 
-                /* Remove this grid from any flow */
-                borg_data_know->data[y][x] = FALSE;
+                    look = &borg_looks[y][x];
+                    old = *look;
+                    feat = ag->feat;
+                    info = ag->info;
 
-                /* Remove this grid from any flow */
-                borg_data_icky->data[y][x] = FALSE;
+                    borg_update_map_grid(y, x);
 
-                /* Recalculate the view (if needed) */
-                if (ag->info & BORG_VIEW) borg_do_update_view = TRUE;
+                    if ((feat == ag->feat) && (info == ag->info) &&
+                        (old.is_take == look->is_take) &&
+                        (old.is_kill == look->is_kill) &&
+                        (!(old.is_take || old.is_kill) ||
+                         ((old.t_a == look->t_a) && (old.t_c == look->t_c))))
+                        continue;
 
-                /* Recalculate the lite (if needed) */
-                if (ag->info & BORG_LIGHT) borg_do_update_light = TRUE;
+                    borg_note(format("# Map update missed grid (%d,%d)", y, x));
+                }
             }
         }
+#endif
+    }
+
+    /* Forget the redrawn grids */
+    for (i = 0; i < borg_map_dirty_n; i++)
+    {
+        borg_map_dirty[borg_map_dirty_y[i]][borg_map_dirty_x[i]] = FALSE;
+    }
+    borg_map_dirty_n = 0;
+    borg_map_full = FALSE;
+
+    /* The torch-lit grids may be forgotten by "borg_update_LIGHT()" */
+    for (i = 0; i < borg_LIGHT_n; i++)
+    {
+        borg_relook_grid(borg_LIGHT_y[i], borg_LIGHT_x[i]);
+    }
+
+    /* Remember the panel and track lists */
+    borg_map_w_x = w_x;
+    borg_map_w_y = w_y;
+    borg_map_track[0] = track_less_num;
+    borg_map_track[1] = track_more_num;
+    borg_map_track[2] = track_glyph_num;
+    borg_map_track[3] = track_closed_num;
+    borg_map_track[4] = track_vein_num;
+
+    /* Collect the monsters/objects on the panel */
+    for (y = w_y; y < w_y + hgt; y++)
+    {
+        /* Skip empty rows */
+        if (!borg_look_wanks[y]) continue;
+
+        for (x = w_x; x < w_x + wid; x++)
+        {
+            borg_wank *wank;
+
+            look = &borg_looks[y][x];
+
+            if (!look->is_take && !look->is_kill) continue;
+
+            /* Check for memory overflow */
+            if (borg_wank_num == AUTO_VIEW_MAX)
+            {
+                borg_note(format("# Wank problem at grid (%d,%d), borg at (%d,%d)",
+                                 y, x, c_y, c_x));
+                borg_oops("too many objects...");
+                return;
+            }
+
+            /* Access next wank, advance */
+            wank = &borg_wanks[borg_wank_num++];
+
+            /* Save some information */
+            wank->x = x;
+            wank->y = y;
+            wank->t_a = look->t_a;
+            wank->t_c = look->t_c;
+            wank->is_take = look->is_take;
+            wank->is_kill = look->is_kill;
+        }
     }
 }
 
@@ -5012,6 +5264,7 @@ void borg_update(void)
         /* No monsters here */
         borg_kills_cnt = 0;
         borg_kills_nxt = 1;
+        borg_danger_forget_all();
 
 		/* In town do certain things */
 		if (borg_skill[BI_CDEPTH] == 0) borg_do_inven = TRUE;
@@ -5557,6 +5810,7 @@ void borg_update(void)
 
 		/* Make sure this grid keeps Floor grid */
 		borg_grids[kill->y][kill->x].feat = FEAT_FLOOR;
+		borg_relook_grid(kill->y, kill->x);
     }
 
 	/* Let me know if I am correctly positioned for special
@@ -6280,6 +6534,9 @@ void borg_init_5(void)
     /* Forget the map */
     borg_forget_map();
 
+    /* Notice grids as the game redraws them */
+    event_add_handler(EVENT_MAP, borg_map_redraw, NULL);
+
 
     /*** Parse "unique" monster names ***/
 
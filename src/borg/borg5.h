@@ -34,6 +34,12 @@ extern void borg_delete_kill(int i);
 extern void borg_delete_take(int i);
 
 
+/*
+ * Look at a grid again on the next update
+ */
+extern void borg_relook_grid(int y, int x);
+
+
 /*
  * Initialize this file
  */
@@ -6221,6 +6221,8 @@ bool borg_target_unknown_wall(int y, int x)
 		{
 			borg_note(format("# Guessing wall (%d,%d) under ghostly target (%d,%d)", n_y, n_x, n_y, n_x));
 			borg_grids[n_y][n_x].feat = FEAT_WALL_EXTRA;
+			borg_relook_grid(n_y, n_x);
+			borg_danger_forget_all();
 			found = TRUE;
 			return (found); /* not sure... should we return here? */
 		}
@@ -6231,6 +6233,8 @@ bool borg_target_unknown_wall(int y, int x)
         {
             borg_note(format("# Guessing wall (%d,%d) near target (%d,%d)", n_y, n_x, y, x));
             borg_grids[n_y][n_x].feat = FEAT_WALL_EXTRA;
+            borg_relook_grid(n_y, n_x);
+            borg_danger_forget_all();
             found = TRUE;
             return (found); /* not sure... should we return here?
                              maybe should mark ALL unknowns in path... */
@@ -6243,6 +6247,8 @@ bool borg_target_unknown_wall(int y, int x)
 			mmove2(&n_y, &n_x, y, x, c_y, c_x);
             borg_note(format("# Guessing wall (%d,%d) near target (%d,%d)", n_y, n_x, y, x));
             if (borg_grids[n_y][n_x].feat == FEAT_NONE) borg_grids[n_y][n_x].feat = FEAT_WALL_EXTRA;
+            borg_relook_grid(n_y, n_x);
+            borg_danger_forget_all();
             return (found);
 		}
 
@@ -10258,7 +10264,11 @@ int borg_attack(bool boosted_bravery, bool inflate, int specific, bool full_simu
 
 			/* Sometimes the borg can lose a monster index in the grid if there are lots of monsters
 			 * on screen.  If he does lose one, reinject the index here. */
-			if (!ag->kill) borg_grids[kill->y][kill->x].kill = i;
+			if (!ag->kill)
+			{
+				borg_grids[kill->y][kill->x].kill = i;
+				borg_danger_forget(kill->y, kill->x);
+			}
 
 			/* Save the location (careful) */
 			borg_temp_x[borg_temp_n] = x;
@@ -17345,6 +17355,7 @@ bool borg_excavate_vault(int range)
 			borg_grids[borg_temp_y[i]][borg_temp_x[i]].info |= BORG_GLOW;
 			/* Feat Floor */
 			borg_grids[borg_temp_y[i]][borg_temp_x[i]].feat = FEAT_FLOOR;
+			borg_relook_grid(borg_temp_y[i], borg_temp_x[i]);
 
 
 
@@ -17540,6 +17551,7 @@ bool borg_excavate_region(int nearness)
 			borg_grids[borg_temp_y[i]][borg_temp_x[i]].info |= BORG_GLOW;
 			/* define as Feat Floor */
 			borg_grids[borg_temp_y[i]][borg_temp_x[i]].feat = FEAT_FLOOR;
+			borg_relook_grid(borg_temp_y[i], borg_temp_x[i]);
 			
 			/* If digging, then i may need to make a new sea */
 			if (distance(glyph_y_center, glyph_x_center, c_y, c_x) >= 10)
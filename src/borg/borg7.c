@@ -5316,137 +5316,171 @@ static byte borg_best_stuff_order[] =
 
 
 /*
- * Helper function (see below)
+ * The items that may go in each slot are gathered once, rather than at
+ * every step of the search, and identical ones are only tried once.
+ *
+ * XXX XXX XXX The search is not pruned.  The power is not the sum of its
+ * parts (items may cross stat, blows, armour class or encumbrance
+ * breakpoints together, or together meet a depth requirement), so no
+ * bound on what the later slots may add would be safe.
+ */
+static byte borg_best_stuff_cand[12][INVEN_PACK + STORE_INVEN_MAX];
+static int borg_best_stuff_num[12];
+static bool borg_best_stuff_encumb;
+
+
+/*
+ * Access an item by its number in the search (home items have 100 added)
  */
-static void borg_best_stuff_aux(int n, byte *test, byte *best, s32b *vp)
+static borg_item *borg_best_stuff_item(int i)
 {
-    int i;
+    if (i < 100) return (&borg_items[i]);
 
-    int slot;
+    return (&borg_shops[STORE_HOME].ware[i - 100]);
+}
 
 
-    /* Extract the slot */
-    slot = borg_best_stuff_order[n];
+/*
+ * Gather the items which may be worn in each slot
+ */
+static void borg_best_stuff_gather(void)
+{
+    int n, i, j;
+
+    /* Note the real state, before any trial */
+    borg_best_stuff_encumb = (borg_skill[BI_ISENCUMB] != 0);
 
-    /* All done */
-    if (slot == 255)
+    for (n = 0; borg_best_stuff_order[n] != 255; n++)
     {
-        s32b p;
+        int slot = borg_best_stuff_order[n];
 
-        /* Examine */
-        borg_notice(FALSE, FALSE);
+        borg_best_stuff_num[n] = 0;
 
-        /* Evaluate */
-        p = borg_power();
-
-        /* Track best */
-        if (p > *vp)
+        for (i = 0; i < ((shop_num == 7) ? (INVEN_MAX_PACK + STORE_INVEN_MAX) : INVEN_MAX_PACK); i++)
         {
+            borg_item *item;
+            int k = (i < INVEN_MAX_PACK) ? i : (i - INVEN_MAX_PACK) + 100;
+
+            item = borg_best_stuff_item(k);
+
+            /* Skip empty items */
+            if (!item->iqty) continue;
+
+            /* Require "aware" */
+            if (!item->kind) continue;
+
+            /* Require "known" (or average, good, etc) */
+            if (!item->ident &&
+                !strstr(item->note, "average") &&
+                !strstr(item->note, "magical") &&
+                !strstr(item->note, "ego") &&
+                !strstr(item->note, "splendid") &&
+                !strstr(item->note, "excellent") &&
+                !strstr(item->note, "indestructible") &&
+                !strstr(item->note, "special")) continue;
+
+            /* Hack -- ignore "worthless" items */
+            if (!item->value) continue;
+
+            /* Skip it if it has not been decursed */
+            if (item->cursed ||
+                of_has(item->flags, OF_LIGHT_CURSE)||
+                of_has(item->flags, OF_HEAVY_CURSE)||
+                of_has(item->flags, OF_PERMA_CURSE)) continue;
+
+            /* Do not wear not *idd* artifacts */
+            if ((op_ptr->opt[OPT_birth_randarts]) &&
+                !item->fully_identified && item->name1) continue;
+
+            /* Make sure it goes in this slot, special consideration for checking rings */
+            if (slot != borg_wield_slot(item)) continue;
+
+            /* Make sure that slot does not have a cursed item */
+            if (borg_items[slot].cursed ||
+                of_has(item->flags, OF_LIGHT_CURSE)||
+                of_has(item->flags, OF_HEAVY_CURSE)||
+                of_has(item->flags, OF_PERMA_CURSE)) continue;
+
+            /* Do not wear certain items if I am over weight limit.  It induces loops */
+            if (borg_best_stuff_encumb)
+            {
+                /* Compare Str bonuses */
+                if (of_has(borg_items[slot].flags, OF_STR) &&
+                    !of_has(item->flags, OF_STR)) continue;
+                /* Compare Str bonuses */
+                else if (of_has(borg_items[slot].flags, OF_STR) &&
+                    of_has(item->flags, OF_STR) &&
+                    borg_items[slot].pval > item->pval) continue;
+            }
 
-#if 0
-            /* dump list and power...  for debugging */
-            borg_note(format("Trying Combo (best power %ld)", *vp));
-            borg_note(format("             (borg_power %ld)", p));
-            for (i = 0; i < INVEN_MAX_PACK; i++)
-                borg_note(format("inv %d %s.",  i, borg_items[i].desc));
-            for (i=0; borg_best_stuff_order[i] != 255; i++)
-                borg_note(format("stuff %s.",
-                    borg_items[borg_best_stuff_order[i]].desc));
-#endif
-            /* Save the results */
-            for (i = 0; i < n; i++) best[i] = test[i];
+            /* An identical item (in the home) would do no better */
+            for (j = 0; j < borg_best_stuff_num[n]; j++)
+            {
+                if (!memcmp(item, borg_best_stuff_item(borg_best_stuff_cand[n][j]),
+                            sizeof(borg_item))) break;
+            }
+            if (j < borg_best_stuff_num[n]) continue;
 
-            /* Use it */
-            *vp = p;
+            /* Save it */
+            borg_best_stuff_cand[n][borg_best_stuff_num[n]++] = k;
         }
-
-        /* Success */
-        return;
     }
+}
 
 
-    /* Note the attempt */
-    test[n] = slot;
-
-    /* Evaluate the default item */
-    borg_best_stuff_aux(n + 1, test, best, vp);
+/*
+ * Helper function (see below)
+ *
+ * Slots from "n" on are wearing their current items, giving power "p".
+ * The later slots are changed first, to try the sets in the same order
+ * as a plain search slot by slot.
+ */
+static void borg_best_stuff_aux(int n, s32b p, byte *test, byte *best, s32b *vp)
+{
+    int i, k;
 
 
-    /* Try other possible objects */
-    for (i = 0; i < ((shop_num == 7) ? (INVEN_MAX_PACK + STORE_INVEN_MAX) : INVEN_MAX_PACK); i++)
+    /* Track best */
+    if (p > *vp)
     {
-        borg_item *item;
-        if (i < INVEN_MAX_PACK)
-            item = &borg_items[i];
-        else
-            item = &borg_shops[STORE_HOME].ware[i - INVEN_MAX_PACK];
-
-        /* Skip empty items */
-        if (!item->iqty) continue;
+        /* Save the results */
+        for (k = 0; borg_best_stuff_order[k] != 255; k++) best[k] = test[k];
 
-        /* Require "aware" */
-        if (!item->kind) continue;
-
-        /* Require "known" (or average, good, etc) */
-        if (!item->ident &&
-            !strstr(item->note, "average") &&
-            !strstr(item->note, "magical") &&
-            !strstr(item->note, "ego") &&
-            !strstr(item->note, "splendid") &&
-            !strstr(item->note, "excellent") &&
-            !strstr(item->note, "indestructible") &&
-            !strstr(item->note, "special")) continue;
-
-        /* Hack -- ignore "worthless" items */
-        if (!item->value) continue;
-
-        /* Skip it if it has not been decursed */
-        if (item->cursed ||
-            of_has(item->flags, OF_LIGHT_CURSE)||
-            of_has(item->flags, OF_HEAVY_CURSE)||
-            of_has(item->flags, OF_PERMA_CURSE)) continue;
+        /* Use it */
+        *vp = p;
+    }
 
-        /* Do not wear not *idd* artifacts */
-        if ((op_ptr->opt[OPT_birth_randarts]) &&
-            !item->fully_identified && item->name1) continue;
+    /* Find the last slot */
+    for (k = n; borg_best_stuff_order[k] != 255; k++) /* loop */;
 
-        /* Make sure it goes in this slot, special consideration for checking rings */
-        if (slot != borg_wield_slot(item)) continue;
+    /* Try other possible objects */
+    while (k-- > n)
+    {
+        int slot = borg_best_stuff_order[k];
 
-        /* Make sure that slot does not have a cursed item */
-        if (borg_items[slot].cursed ||
-            of_has(item->flags, OF_LIGHT_CURSE)||
-            of_has(item->flags, OF_HEAVY_CURSE)||
-            of_has(item->flags, OF_PERMA_CURSE)) continue;
+        for (i = 0; i < borg_best_stuff_num[k]; i++)
+        {
+            s32b v;
 
-		/* Do not wear certain items if I am over weight limit.  It induces loops */
-		if (borg_skill[BI_ISENCUMB])
-		{
-			/* Compare Str bonuses */
-			if (of_has(borg_items[slot].flags, OF_STR) &&
-				!of_has(item->flags, OF_STR)) continue;
-			/* Compare Str bonuses */
-			else if (of_has(borg_items[slot].flags, OF_STR) &&
-				of_has(item->flags, OF_STR) &&
-				borg_items[slot].pval > item->pval) continue;
-		}
+            /* Wear the new item */
+            COPY(&borg_items[slot], borg_best_stuff_item(borg_best_stuff_cand[k][i]), borg_item);
 
-        /* Wear the new item */
-        COPY(&borg_items[slot], item, borg_item);
+            /* Note the attempt */
+            test[k] = borg_best_stuff_cand[k][i];
 
-        /* Note the attempt */
-        if (i < INVEN_MAX_PACK)
-            test[n] = i;
-        else
-            /* if in home, note by adding 100 to item number. */
-            test[n] = (i - INVEN_MAX_PACK) + 100;
+            /* Examine */
+            borg_notice(FALSE, FALSE);
 
+            /* Evaluate */
+            v = borg_power();
 
-        /* Evaluate the possible item */
-        borg_best_stuff_aux(n + 1, test, best, vp);
+            /* Evaluate the sets with the possible item */
+            borg_best_stuff_aux(k + 1, v, test, best, vp);
 
-        /* Restore equipment */
-        COPY(&borg_items[slot], &safe_items[slot], borg_item);
+            /* Restore equipment */
+            COPY(&borg_items[slot], &safe_items[slot], borg_item);
+            test[k] = slot;
+        }
     }
 }
 
@@ -5461,7 +5495,7 @@ bool borg_best_stuff(void)
     int k;
 
 
-    s32b value;
+    s32b value, base;
 
     int i;
 	int p;
@@ -5477,7 +5511,8 @@ bool borg_best_stuff(void)
     for (k = 0; k < 12; k++)
     {
         /* Initialize */
-        best[k] = test[k] = 255;
+        best[k] = 255;
+        test[k] = borg_best_stuff_order[k];
     }
 
     /* Hack -- Copy all the slots */
@@ -5503,8 +5538,15 @@ bool borg_best_stuff(void)
     /* Evaluate the inventory */
     value = my_power;
 
+    /* Gather the possible items */
+    borg_best_stuff_gather();
+
+    /* Evaluate the current equipment */
+    borg_notice(FALSE, FALSE);
+    base = borg_power();
+
     /* Determine the best possible equipment */
-    (void)borg_best_stuff_aux(0, test, best, &value);
+    borg_best_stuff_aux(0, base, test, best, &value);
 
     /* Restore bonuses */
     borg_notice(TRUE, TRUE);
@@ -4968,6 +4968,7 @@ bool borg_think_dungeon(void)
         /* No monsters here */
         borg_kills_cnt = 0;
         borg_kills_nxt = 1;
+        borg_danger_forget_all();
 
         /* Forget old monsters */
         C_WIPE(borg_kills, 256, borg_kill);
@@ -6051,6 +6052,7 @@ bool borg_think_dungeon(void)
     /* No monsters here */
     borg_kills_cnt = 0;
     borg_kills_nxt = 1;
+    borg_danger_forget_all();
 
 	/* Attempt to dig to the center of the dungeon */
 	if (borg_flow_kill_direct(TRUE, TRUE)) return (TRUE);
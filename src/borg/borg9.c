@@ -1356,8 +1356,12 @@ static bool borg_think(void)
     /* Hack -- allow user abort */
     if (borg_cancel) return (TRUE);
 
-    /* Do something */
-    return (borg_think_dungeon());
+    /* Do something, keeping the danger of each grid while deciding */
+    borg_danger_keep(TRUE);
+    i = borg_think_dungeon();
+    borg_danger_keep(FALSE);
+
+    return (i);
 }
 
 
@@ -89,8 +89,10 @@ int distance(int y1, int x1, int y2, int x2)
  * are "viewable" by the player, which is used for many things, such as
  * determining which grids are illuminated by the player's torch, and which
  * grids and monsters can be "seen" by the player, etc).
+ *
+ * See los() for the cached version.
  */
-bool los(int y1, int x1, int y2, int x2)
+static bool los_aux(int y1, int x1, int y2, int x2)
 {
 	/* Delta */
 	int dx, dy;
@@ -309,6 +311,109 @@ bool los(int y1, int x1, int y2, int x2)
 }
 
 
+/*
+ * Flags of a line of sight cache entry
+ */
+#define LOS_KNOWN	0x01	/* The los() answer is known */
+#define LOS_YES		0x02	/* There is line of sight */
+#define PROJ_KNOWN	0x04	/* The projectable() answer is known */
+#define PROJ_YES	0x08	/* The target is projectable */
+
+/*
+ * The line of sight cache.
+ *
+ * Monsters ask the same questions of los() and projectable() many times a
+ * turn, so the answers are remembered in a hash table, with one entry for
+ * each (source, target) pair that fits.  Both answers depend only on which
+ * grids have CAVE_WALL set, and only on grids in the rectangle spanned by
+ * source and target, since the paths never leave it.
+ *
+ * cave_set_feat() records each grid whose CAVE_WALL flag changes in a ring
+ * of the latest LOS_CACHE_CHANGES changes.  An entry that has fallen behind
+ * is checked against the changes it missed, and is only thrown away if one
+ * of them lies in its rectangle.  An entry which is further behind than the
+ * ring reaches is thrown away anyway.
+ */
+static struct los_entry *los_cache_find(struct cave *c, int y1, int x1,
+	int y2, int x2)
+{
+	u16b from = GRID(y1, x1);
+	u16b to = GRID(y2, x2);
+	u32b hash = ((u32b)from << 16 | to) * 2654435761U;
+	struct los_entry *e = &c->los_cache[hash >> 20 & (LOS_CACHE_SIZE - 1)];
+	u32b missed;
+
+	/* A different pair, or nothing at all */
+	if (e->from != from || e->to != to || !e->flags) {
+		e->from = from;
+		e->to = to;
+		e->when = c->los_when;
+		e->flags = 0;
+		return e;
+	}
+
+	/* Too far behind to check */
+	missed = c->los_when - e->when;
+	if (missed > LOS_CACHE_CHANGES) {
+		e->flags = 0;
+	} else {
+		int ylo = MIN(y1, y2), yhi = MAX(y1, y2);
+		int xlo = MIN(x1, x2), xhi = MAX(x1, x2);
+
+		/* Check the changes since the entry was last good */
+		while (missed--) {
+			u16b g = c->los_changed[(e->when + missed) % LOS_CACHE_CHANGES];
+			int y = GRID_Y(g), x = GRID_X(g);
+
+			if (y >= ylo && y <= yhi && x >= xlo && x <= xhi) {
+				e->flags = 0;
+				break;
+			}
+		}
+	}
+
+	e->when = c->los_when;
+	return e;
+}
+
+/*
+ * Note that a grid has started or stopped blocking line of sight.
+ */
+static void cave_los_note_feat(struct cave *c, int y, int x)
+{
+	c->los_changed[c->los_when % LOS_CACHE_CHANGES] = GRID(y, x);
+	c->los_when++;
+}
+
+/*
+ * Forget everything in the line of sight cache, for a new level.
+ */
+void cave_forget_los(struct cave *c)
+{
+	c->los_when += LOS_CACHE_CHANGES + 1;
+}
+
+/*
+ * Determine if a line of sight can be traced between two grids; see
+ * los_aux() for the details.
+ */
+bool los(int y1, int x1, int y2, int x2)
+{
+	struct los_entry *e;
+
+	/* Handle adjacent (or identical) grids */
+	if ((ABS(y2 - y1) < 2) && (ABS(x2 - x1) < 2)) return (TRUE);
+
+	e = los_cache_find(cave, y1, x1, y2, x2);
+	if (!(e->flags & LOS_KNOWN)) {
+		e->flags |= LOS_KNOWN;
+		if (los_aux(y1, x1, y2, x2)) e->flags |= LOS_YES;
+	}
+
+	return (e->flags & LOS_YES) ? TRUE : FALSE;
+}
+
+
 
 
 /*
@@ -1243,6 +1348,45 @@ void prt_map(void)
 }
 
 
+/*
+ * Work out the size of the "small-scale" map for the active Term, and of
+ * the part of the level it shows.  Returns FALSE if there is no room.
+ */
+static bool display_map_size(int *map_hgt, int *map_wid, int *dungeon_hgt,
+		int *dungeon_wid)
+{
+	/* Desired map height */
+	*map_hgt = Term->hgt - 2;
+	*map_wid = Term->wid - 2;
+
+	*dungeon_hgt = (p_ptr->depth == 0) ? TOWN_HGT : DUNGEON_HGT;
+	*dungeon_wid = (p_ptr->depth == 0) ? TOWN_WID : DUNGEON_WID;
+
+	/* Prevent accidents */
+	if (*map_hgt > *dungeon_hgt) *map_hgt = *dungeon_hgt;
+	if (*map_wid > *dungeon_wid) *map_wid = *dungeon_wid;
+
+	/* Prevent accidents */
+	return (*map_wid >= 1) && (*map_hgt >= 1);
+}
+
+
+/*
+ * Find the cell of the "small-scale" map which shows grid (y, x)
+ */
+static void display_map_cell(int y, int x, int map_hgt, int map_wid,
+		int dungeon_hgt, int dungeon_wid, int *row, int *col)
+{
+	*row = (y * map_hgt / dungeon_hgt);
+	*col = (x * map_wid / dungeon_wid);
+
+	if (tile_width > 1)
+		*col = *col - (*col % tile_width);
+	if (tile_height > 1)
+		*row = *row - (*row % tile_height);
+}
+
+
 /*
  * Display a "small-scale" map of the dungeon in the active Term.
  *
@@ -1280,19 +1424,9 @@ void display_map(int *cy, int *cx)
 
 	monster_race *r_ptr = &r_info[0];
 
-	/* Desired map height */
-	map_hgt = Term->hgt - 2;
-	map_wid = Term->wid - 2;
-
-	dungeon_hgt = (p_ptr->depth == 0) ? TOWN_HGT : DUNGEON_HGT;
-	dungeon_wid = (p_ptr->depth == 0) ? TOWN_WID : DUNGEON_WID;
-
 	/* Prevent accidents */
-	if (map_hgt > dungeon_hgt) map_hgt = dungeon_hgt;
-	if (map_wid > dungeon_wid) map_wid = dungeon_wid;
-
-	/* Prevent accidents */
-	if ((map_wid < 1) || (map_hgt < 1)) return;
+	if (!display_map_size(&map_hgt, &map_wid, &dungeon_hgt, &dungeon_wid))
+		return;
 
 
 	/* Nothing here */
@@ -1318,13 +1452,8 @@ void display_map(int *cy, int *cx)
 	{
 		for (x = 0; x < dungeon_wid; x++)
 		{
-			row = (y * map_hgt / dungeon_hgt);
-			col = (x * map_wid / dungeon_wid);
-
-			if (tile_width > 1)
-				col = col - (col % tile_width);
-			if (tile_height > 1)
-				row = row - (row % tile_height);
+			display_map_cell(y, x, map_hgt, map_wid, dungeon_hgt, dungeon_wid,
+					&row, &col);
 
 			/* Get the attr/char at that map location */
 			map_info(y, x, &g);
@@ -1354,13 +1483,8 @@ void display_map(int *cy, int *cx)
 	/*** Display the player ***/
 
 	/* Player location */
-	row = (py * map_hgt / dungeon_hgt);
-	col = (px * map_wid / dungeon_wid);
-
-	if (tile_width > 1)
-		col = col - (col % tile_width);
-	if (tile_height > 1)
-		row = row - (row % tile_height);
+	display_map_cell(py, px, map_hgt, map_wid, dungeon_hgt, dungeon_wid,
+			&row, &col);
 
 	/* Get the "player" tile */
 	ta = r_ptr->x_attr;
@@ -1378,6 +1502,215 @@ void display_map(int *cy, int *cx)
 }
 
 
+/*
+ * Draw one cell of a minimap from the grids under it, as display_map()
+ * would
+ */
+static void minimap_draw_cell(struct minimap *m, int row, int col)
+{
+	int x, y;
+	grid_data g;
+
+	byte ta = TERM_WHITE;
+	wchar_t tc = L' ';
+
+	byte tp, best = 0;
+
+	for (y = m->first_y[row]; y < m->dungeon_hgt && m->cell_y[y] == row; y++)
+	{
+		for (x = m->first_x[col]; x < m->dungeon_wid && m->cell_x[x] == col; x++)
+		{
+			/* Get the attr/char at that map location */
+			map_info(y, x, &g);
+
+			/* Get the priority of that attr/char */
+			tp = f_info[g.f_idx].priority;
+
+			/* Save "best" */
+			if (best < tp)
+			{
+				/* Hack - make every grid on the map lit */
+				g.lighting = FEAT_LIGHTING_LIT;
+				grid_data_as_text(&g, &ta, &tc, &ta, &tc);
+
+				best = tp;
+			}
+		}
+	}
+
+	/* Nothing here, or the best character */
+	Term_putch(col + 1, row + 1, ta, tc);
+
+	if ((tile_width > 1) || (tile_height > 1))
+		Term_big_putch(col + 1, row + 1, ta, tc);
+}
+
+
+/*
+ * Note that grid (y, x) has changed, so the minimap cell over it must be
+ * drawn again.  (-1, -1) means the whole level may have changed.
+ */
+void minimap_mark(struct minimap *m, int y, int x)
+{
+	int row, col, cell;
+
+	/* Everything is drawn anyway */
+	if (!m->drawn || m->redraw) return;
+
+	/* Whole level */
+	if ((y < 0) || (x < 0))
+	{
+		m->redraw = TRUE;
+		return;
+	}
+
+	/* Not on the map */
+	if ((y >= m->dungeon_hgt) || (x >= m->dungeon_wid)) return;
+
+	row = m->cell_y[y];
+	col = m->cell_x[x];
+	cell = row * m->map_wid + col;
+
+	/* Already noted */
+	if (m->dirty[cell]) return;
+
+	m->dirty[cell] = TRUE;
+	m->dirty_cells[m->dirty_n++] = cell;
+}
+
+
+/*
+ * Free what a minimap has allocated; it starts again when next displayed.
+ */
+void minimap_free(struct minimap *m)
+{
+	FREE(m->dirty);
+	FREE(m->dirty_cells);
+	m->dirty_n = 0;
+	m->drawn = FALSE;
+}
+
+
+/*
+ * Bring a minimap in the active Term up to date.
+ *
+ * The whole map is only drawn again when the level or the size of the Term
+ * has changed, or when the whole level may have changed; otherwise only the
+ * cells over the grids passed to minimap_mark() are.
+ */
+void minimap_display(struct minimap *m)
+{
+	int map_hgt, map_wid, dungeon_hgt, dungeon_wid;
+	int row, col, x, y, i;
+
+	monster_race *r_ptr = &r_info[0];
+
+	if (!display_map_size(&map_hgt, &map_wid, &dungeon_hgt, &dungeon_wid))
+		return;
+
+	/* New level, or a new size */
+	if ((m->created_at != cave->created_at) || (m->depth != p_ptr->depth) ||
+		(m->map_hgt != map_hgt) || (m->map_wid != map_wid) ||
+		(m->tile_hgt != tile_height) || (m->tile_wid != tile_width))
+		m->drawn = FALSE;
+
+	/* Start again */
+	if (!m->drawn)
+	{
+		m->created_at = cave->created_at;
+		m->depth = p_ptr->depth;
+		m->map_hgt = map_hgt;
+		m->map_wid = map_wid;
+		m->dungeon_hgt = dungeon_hgt;
+		m->dungeon_wid = dungeon_wid;
+		m->tile_hgt = tile_height;
+		m->tile_wid = tile_width;
+
+		/* Find the cell over every grid, and the first grid under each */
+		for (y = dungeon_hgt - 1; y >= 0; y--)
+		{
+			display_map_cell(y, 0, map_hgt, map_wid, dungeon_hgt, dungeon_wid,
+					&row, &col);
+			m->cell_y[y] = row;
+			m->first_y[row] = y;
+		}
+		for (x = dungeon_wid - 1; x >= 0; x--)
+		{
+			display_map_cell(0, x, map_hgt, map_wid, dungeon_hgt, dungeon_wid,
+					&row, &col);
+			m->cell_x[x] = col;
+			m->first_x[col] = x;
+		}
+
+		m->dirty = mem_realloc(m->dirty, map_hgt * map_wid * sizeof(bool));
+		m->dirty_cells = mem_realloc(m->dirty_cells,
+				map_hgt * map_wid * sizeof(int));
+		memset(m->dirty, 0, map_hgt * map_wid * sizeof(bool));
+		m->dirty_n = 0;
+
+		Term_clear();
+
+		/* Draw a box around the edge of the term */
+		window_make(0, 0, map_wid + 1, map_hgt + 1);
+
+		m->redraw = TRUE;
+		m->drawn = TRUE;
+	}
+
+	/* Every cell with a grid under it */
+	if (m->redraw)
+	{
+		for (y = 0; y < dungeon_hgt; y++)
+		{
+			if (y && m->cell_y[y] == m->cell_y[y - 1]) continue;
+
+			for (x = 0; x < dungeon_wid; x++)
+			{
+				if (x && m->cell_x[x] == m->cell_x[x - 1]) continue;
+
+				minimap_draw_cell(m, m->cell_y[y], m->cell_x[x]);
+			}
+		}
+
+		m->redraw = FALSE;
+	}
+
+	/* Just the changed cells */
+	else
+	{
+		for (i = 0; i < m->dirty_n; i++)
+			minimap_draw_cell(m, m->dirty_cells[i] / map_wid,
+					m->dirty_cells[i] % map_wid);
+	}
+
+	for (i = 0; i < m->dirty_n; i++)
+		m->dirty[m->dirty_cells[i]] = FALSE;
+	m->dirty_n = 0;
+
+	/*** Display the player ***/
+
+	/* Player location */
+	row = m->cell_y[p_ptr->py];
+	col = m->cell_x[p_ptr->px];
+
+	/* Draw the cell the player left */
+	if ((row != m->player_row) || (col != m->player_col))
+	{
+		if ((m->player_row < map_hgt) && (m->player_col < map_wid))
+			minimap_draw_cell(m, m->player_row, m->player_col);
+
+		m->player_row = row;
+		m->player_col = col;
+	}
+
+	/* Draw the player */
+	Term_putch(col + 1, row + 1, r_ptr->x_attr, r_ptr->x_char);
+
+	if ((tile_width > 1) || (tile_height > 1))
+		Term_big_putch(col + 1, row + 1, r_ptr->x_attr, r_ptr->x_char);
+}
+
+
 /*
  * Display a "small-scale" map of the dungeon.
  *
@@ -2275,6 +2608,26 @@ errr vinfo_init(void)
 
 
 
+/*
+ * Everything the last update_view() depended on, so that it need not be
+ * repeated while none of it changes.  Changes of CAVE_GLOW always come with
+ * PU_FORGET_VIEW, and changes of CAVE_WALL are counted by "los_when" in the
+ * cave (see cave_set_feat()).  With more than VIEW_LIGHTS monsters carrying
+ * light the view is always worked out again.
+ */
+#define VIEW_LIGHTS	32
+
+static struct {
+	bool valid;
+	int py, px;
+	int radius;
+	bool blind;
+	u32b walls;
+	int lights_n;
+	u16b lights[VIEW_LIGHTS];	/* Grids of monsters carrying light */
+} view_key;
+
+
 /*
  * Forget the "CAVE_VIEW" grids, redrawing as needed
  */
@@ -2288,6 +2641,8 @@ void forget_view(void)
 	/* XXX: this is moronic. It's not 'fast'. */
 	byte *fast_cave_info = &cave->info[0][0];
 
+	/* The next update_view() must do the work */
+	view_key.valid = FALSE;
 
 	/* None to forget */
 	if (!fast_view_n) return;
@@ -2409,6 +2764,10 @@ void forget_view(void)
  * their children, and the queue must be able to hold several of these
  * special grids.  Because the actual number of required grids is bizarre,
  * we simply allocate twice as many as we would normally need.  XXX XXX XXX
+ *
+ * Nothing is done if nothing the field of view depends on has changed since
+ * the last call, which saves the whole calculation while resting, searching
+ * or standing still.  See "view_key" above.
  */
 void update_view(void)
 {
@@ -2432,9 +2791,50 @@ void update_view(void)
 
 	byte info;
 
+	int lights_n = 0;
+	u16b lights[VIEW_LIGHTS];
+
 
 	/*** Step 0 -- Begin ***/
 
+	/* Extract "radius" value */
+	radius = p_ptr->cur_light;
+
+	/* Handle real light */
+	if (radius > 0) ++radius;
+
+	/* Note where the monsters carrying light are */
+	for (k = 1; k < cave_monster_max(cave); k++)
+	{
+		monster_type *m_ptr = cave_monster(cave, k);
+
+		if (!m_ptr->r_idx) continue;
+		if (!rf_has(r_info[m_ptr->r_idx].flags, RF_HAS_LIGHT)) continue;
+
+		if (lights_n < VIEW_LIGHTS)
+			lights[lights_n] = GRID(m_ptr->fy, m_ptr->fx);
+		lights_n++;
+	}
+
+	/* Nothing has changed */
+	if (view_key.valid && (view_key.py == py) && (view_key.px == px) &&
+	    (view_key.radius == radius) &&
+	    (view_key.blind == (p_ptr->timed[TMD_BLIND] != 0)) &&
+	    (view_key.walls == cave->los_when) &&
+	    (view_key.lights_n == lights_n) && (lights_n <= VIEW_LIGHTS) &&
+	    !memcmp(view_key.lights, lights, lights_n * sizeof(u16b)))
+		return;
+
+	/* Remember what this view depends on */
+	view_key.valid = TRUE;
+	view_key.py = py;
+	view_key.px = px;
+	view_key.radius = radius;
+	view_key.blind = (p_ptr->timed[TMD_BLIND] != 0);
+	view_key.walls = cave->los_when;
+	view_key.lights_n = lights_n;
+	memcpy(view_key.lights, lights, MIN(lights_n, VIEW_LIGHTS) * sizeof(u16b));
+
 	/* Save the old "view" grids for later */
 	for (i = 0; i < fast_view_n; i++)
 	{
@@ -2467,14 +2867,8 @@ void update_view(void)
 	/* Reset the "view" array */
 	fast_view_n = 0;
 
-	/* Extract "radius" value */
-	radius = p_ptr->cur_light;
-
-	/* Handle real light */
-	if (radius > 0) ++radius;
-
 	/* Scan monster list and add monster lights */
-	for (k = 1; k < z_info->m_max; k++)
+	for (k = 1; lights_n && k < cave_monster_max(cave); k++)
 	{
 		/* Check the k'th monster */
 		monster_type *m_ptr = cave_monster(cave, k);
@@ -2484,7 +2878,7 @@ void update_view(void)
 		int fx = m_ptr->fx;
 		int fy = m_ptr->fy;
 
-		bool in_los = los(p_ptr->py, p_ptr->px, fy, fx);
+		bool in_los;
 
 		/* Skip dead monsters */
 		if (!m_ptr->r_idx) continue;
@@ -2492,6 +2886,8 @@ void update_view(void)
 		/* Skip monsters not carrying light */
 		if (!rf_has(r_ptr->flags, RF_HAS_LIGHT)) continue;
 
+		in_los = los(p_ptr->py, p_ptr->px, fy, fx);
+
 		/* Light a 3x3 box centered on the monster */
 		for (i = -1; i <= 1; i++)
 		{
@@ -2806,17 +3202,37 @@ void update_view(void)
  * This entry is the "current index" for the "when" field
  * Note that a "when" value of "zero" means "not used".
  *
- * Note that the "cost" indexes from 1 to 127 are for
- * "old" data, and from 128 to 255 are for "new" data.
+ * Every call to cave_update_flow() which does any work takes a new stamp,
+ * and the stamps only ever increase, so "when" keeps the order in which
+ * grids were last near the player without ever being aged. Any monster
+ * can track down either the player or a position recently occupied by the
+ * player, however long ago.
  *
- * This means that as long as the player does not "teleport",
- * then any monster up to 128 + MONSTER_FLOW_DEPTH will be
- * able to track down the player, and in general, will be
- * able to track down either the player or a position recently
- * occupied by the player.
+ * Stamps below "flow_floor" have been forgotten, and read as zero through
+ * cave_flow_when(), so forgetting the flow does not touch the grid.
+ */
+static u32b flow_save = 0;
+static u32b flow_floor = 1;
+
+/*
+ * Where the player stood for the last flow, and whether the terrain in
+ * reach of it has changed since.
+ */
+static int flow_py = -1;
+static int flow_px = -1;
+static bool flow_stale = TRUE;
+
+
+/*
+ * Return the flow stamp of a grid, or zero if the player has never been
+ * near it (or it has been forgotten since).
  */
-static int flow_save = 0;
+u32b cave_flow_when(struct cave *c, int y, int x)
+{
+	u32b w = c->when[y][x];
 
+	return (w >= flow_floor) ? w : 0;
+}
 
 
 /*
@@ -2824,24 +3240,37 @@ static int flow_save = 0;
  */
 void cave_forget_flow(struct cave *c)
 {
-	int x, y;
+	/* Everything stamped so far is now forgotten */
+	flow_floor = flow_save + 1;
+
+	/* The next update must rebuild the flow */
+	flow_stale = TRUE;
+}
 
-	/* Nothing to forget */
-	if (!flow_save) return;
 
-	/* Check the entire dungeon */
-	for (y = 0; y < DUNGEON_HGT; y++)
+/*
+ * Note that the grid at (y, x) has become passable or impassable.
+ *
+ * The flow only needs rebuilding if the grid is in, or next to, the area
+ * reached by the last update; other changes cannot alter any cost.
+ */
+static void cave_flow_note_feat(struct cave *c, int y, int x, bool blocked)
+{
+	int d;
+
+	for (d = 0; d < 9 && !flow_stale; d++)
 	{
-		for (x = 0; x < DUNGEON_WID; x++)
-		{
-			/* Forget the old data */
-			c->cost[y][x] = 0;
-			c->when[y][x] = 0;
-		}
+		int yy = y + ddy_ddd[d];
+		int xx = x + ddx_ddd[d];
+
+		if (!in_bounds(yy, xx)) continue;
+
+		if (flow_save >= flow_floor && c->when[yy][xx] == flow_save)
+			flow_stale = TRUE;
 	}
 
-	/* Start over */
-	flow_save = 0;
+	/* A grid that is now a wall can no longer be followed by scent */
+	if (blocked) c->when[y][x] = 0;
 }
 
 
@@ -2853,6 +3282,9 @@ void cave_forget_flow(struct cave *c)
  * In addition, mark the "when" of the grids that can reach the player
  * with the incremented value of "flow_save".
  *
+ * Nothing is done if the player has not moved and no terrain in reach
+ * of the last flow has changed, since the costs would come out the same.
+ *
  * Hack -- use the local "flow_y" and "flow_x" arrays as a "circular
  * queue" of cave grids.
  *
@@ -2870,7 +3302,7 @@ void cave_update_flow(struct cave *c)
 
 	int n, d;
 
-	int flow_n;
+	u32b flow_n;
 
 	int flow_tail = 0;
 	int flow_head = 0;
@@ -2879,27 +3311,31 @@ void cave_update_flow(struct cave *c)
 	byte flow_x[FLOW_MAX];
 
 
+	/*** Check the flow ***/
+
+	/* The last flow is still correct */
+	if (!flow_stale && (py == flow_py) && (px == flow_px)) return;
+
+	flow_py = py;
+	flow_px = px;
+	flow_stale = FALSE;
+
+
 	/*** Cycle the flow ***/
 
-	/* Cycle the flow */
-	if (flow_save++ == 255)
+	/* Out of stamps (not in this lifetime) -- start again from scratch */
+	if (flow_save == 0xFFFFFFFFUL)
 	{
-		/* Cycle the flow */
 		for (y = 0; y < DUNGEON_HGT; y++)
-		{
 			for (x = 0; x < DUNGEON_WID; x++)
-			{
-				int w = c->when[y][x];
-				c->when[y][x] = (w >= 128) ? (w - 128) : 0;
-			}
-		}
+				c->when[y][x] = 0;
 
-		/* Restart */
-		flow_save = 128;
+		flow_save = 0;
+		flow_floor = 1;
 	}
 
 	/* Local variable */
-	flow_n = flow_save;
+	flow_n = ++flow_save;
 
 
 	/*** Player Grid ***/
@@ -3163,6 +3599,14 @@ void cave_set_feat(struct cave *c, int y, int x, int feat)
 	/* XXX: Check against c->height and c->width instead, once everywhere
 	 * honors those... */
 
+	/* Passability for monster flow has changed */
+	if ((c->feat[y][x] >= FEAT_RUBBLE) != (feat >= FEAT_RUBBLE))
+		cave_flow_note_feat(c, y, x, feat >= FEAT_RUBBLE);
+
+	/* Line of sight through the grid has changed */
+	if (((c->info[y][x] & CAVE_WALL) != 0) != (feat >= FEAT_DOOR_HEAD))
+		cave_los_note_feat(c, y, x);
+
 	c->feat[y][x] = feat;
 
 	if (feat >= FEAT_DOOR_HEAD)
@@ -3464,7 +3908,7 @@ int project_path(u16b *gp, int range, int y1, int x1, int y2, int x2, int flg)
  * This function is used to determine if the player can (easily) target
  * a given grid, and if a monster can target the player.
  */
-bool projectable(int y1, int x1, int y2, int x2, int flg)
+static bool projectable_aux(int y1, int x1, int y2, int x2, int flg)
 {
 	int y, x;
 
@@ -3491,6 +3935,27 @@ bool projectable(int y1, int x1, int y2, int x2, int flg)
 	return (TRUE);
 }
 
+/*
+ * Determine if a bolt will arrive; see projectable_aux().
+ *
+ * The answer is cached (see los_cache_find()) unless "flg" asks about
+ * monsters in the way, which the cache knows nothing about.
+ */
+bool projectable(int y1, int x1, int y2, int x2, int flg)
+{
+	struct los_entry *e;
+
+	if (flg != PROJECT_NONE) return projectable_aux(y1, x1, y2, x2, flg);
+
+	e = los_cache_find(cave, y1, x1, y2, x2);
+	if (!(e->flags & PROJ_KNOWN)) {
+		e->flags |= PROJ_KNOWN;
+		if (projectable_aux(y1, x1, y2, x2, flg)) e->flags |= PROJ_YES;
+	}
+
+	return (e->flags & PROJ_YES) ? TRUE : FALSE;
+}
+
 
 
 /*
@@ -3643,13 +4108,19 @@ struct cave *cave_new(void) {
 	c->info2 = C_ZNEW(DUNGEON_HGT, byte_256);
 	c->feat = C_ZNEW(DUNGEON_HGT, byte_wid);
 	c->cost = C_ZNEW(DUNGEON_HGT, byte_wid);
-	c->when = C_ZNEW(DUNGEON_HGT, byte_wid);
+	c->when = C_ZNEW(DUNGEON_HGT, u32b_wid);
 	c->m_idx = C_ZNEW(DUNGEON_HGT, s16b_wid);
 	c->o_idx = C_ZNEW(DUNGEON_HGT, s16b_wid);
 
 	c->monsters = C_ZNEW(z_info->m_max, struct monster);
 	c->mon_max = 1;
 
+	c->mon_words = (z_info->m_max + 31) / 32;
+	c->mon_ready = C_ZNEW(c->mon_words, u32b);
+	c->mon_wheel = C_ZNEW(MON_WHEEL * c->mon_words, u32b);
+
+	c->los_cache = C_ZNEW(LOS_CACHE_SIZE, struct los_entry);
+
 	c->created_at = 1;
 	return c;
 }
@@ -3663,6 +4134,9 @@ void cave_free(struct cave *c) {
 	mem_free(c->m_idx);
 	mem_free(c->o_idx);
 	mem_free(c->monsters);
+	mem_free(c->mon_ready);
+	mem_free(c->mon_wheel);
+	mem_free(c->los_cache);
 	mem_free(c);
 }
 
@@ -9,6 +9,7 @@
 
 struct player;
 struct monster;
+struct minimap;
 
 extern int distance(int y1, int x1, int y2, int x2);
 extern bool los(int y1, int x1, int y2, int x2);
@@ -20,6 +21,9 @@ extern void move_cursor_relative(int y, int x);
 extern void print_rel(wchar_t c, byte a, int y, int x);
 extern void prt_map(void);
 extern void display_map(int *cy, int *cx);
+extern void minimap_mark(struct minimap *m, int y, int x);
+extern void minimap_display(struct minimap *m);
+extern void minimap_free(struct minimap *m);
 extern void do_cmd_view_map(void);
 extern errr vinfo_init(void);
 extern void forget_view(void);
@@ -39,6 +43,60 @@ extern void disturb(struct player *p, int stop_search, int unused_flag);
 extern bool is_quest(int level);
 extern bool dtrap_edge(int y, int x);
 
+/*
+ * Game turns of monster schedule kept ahead; more than any monster can
+ * take to gain 100 energy (see mon-util.c)
+ */
+#define MON_WHEEL	128
+
+/*
+ * Size of the line of sight cache, and how many of the latest changes of
+ * terrain its entries can be checked against (see cave.c)
+ */
+#define LOS_CACHE_SIZE		4096
+#define LOS_CACHE_CHANGES	64
+
+/*
+ * A remembered answer from los() or projectable() for one pair of grids
+ */
+struct los_entry {
+	u16b from;		/* GRID() of the source */
+	u16b to;		/* GRID() of the target */
+	u32b when;		/* Changes of terrain when last known good */
+	byte flags;		/* LOS_* flags (see cave.c) */
+};
+
+/*
+ * A "small-scale" map kept in a subwindow, which only draws again the
+ * cells over grids that have changed (see cave.c)
+ */
+struct minimap {
+	bool drawn;		/* Drawn for the current level and size */
+	bool redraw;		/* Draw every cell again */
+
+	s32b created_at;	/* Level, as cave->created_at and p_ptr->depth */
+	int depth;
+
+	int map_hgt;		/* Cells, as display_map() sizes them */
+	int map_wid;
+	int dungeon_hgt;	/* Grids shown */
+	int dungeon_wid;
+	int tile_hgt;
+	int tile_wid;
+
+	byte cell_y[DUNGEON_HGT];	/* Cell row over each row of grids */
+	byte cell_x[DUNGEON_WID];	/* Cell column over each column of grids */
+	byte first_y[DUNGEON_HGT];	/* First row of grids under each cell row */
+	byte first_x[DUNGEON_WID];	/* First column of grids under each column */
+
+	bool *dirty;		/* Cells to draw again */
+	int *dirty_cells;
+	int dirty_n;
+
+	int player_row;		/* Cell the player was drawn in */
+	int player_col;
+};
+
 struct cave {
 	s32b created_at;
 	int depth;
@@ -57,13 +115,24 @@ struct cave {
 	byte (*info2)[256];
 	byte (*feat)[DUNGEON_WID];
 	byte (*cost)[DUNGEON_WID];
-	byte (*when)[DUNGEON_WID];
+	u32b (*when)[DUNGEON_WID];
 	s16b (*m_idx)[DUNGEON_WID];
 	s16b (*o_idx)[DUNGEON_WID];
 
 	struct monster *monsters;
 	int mon_max;
 	int mon_cnt;
+
+	/* Monster schedule, as bitmaps over monster indexes */
+	s32b mon_turn;		/* Game turns of energy given out */
+	int mon_words;		/* u32b words in each bitmap */
+	u32b *mon_ready;	/* Monsters with 100 energy or more */
+	u32b *mon_wheel;	/* MON_WHEEL bitmaps of monsters by turn due */
+
+	/* Line of sight cache */
+	struct los_entry *los_cache;
+	u32b los_when;		/* Changes of terrain that block sight so far */
+	u16b los_changed[LOS_CACHE_CHANGES];	/* The latest changed grids */
 };
 
 /* XXX: temporary while I refactor */
@@ -77,6 +146,8 @@ extern void cave_note_spot(struct cave *c, int y, int x);
 extern void cave_light_spot(struct cave *c, int y, int x);
 extern void cave_update_flow(struct cave *c);
 extern void cave_forget_flow(struct cave *c);
+extern u32b cave_flow_when(struct cave *c, int y, int x);
+extern void cave_forget_los(struct cave *c);
 extern void cave_illuminate(struct cave *c, bool daytime);
 
 /**
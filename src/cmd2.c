@@ -572,8 +572,8 @@ static bool twall(int y, int x)
 	/* Update the visuals */
 	p_ptr->update |= (PU_UPDATE_VIEW | PU_MONSTERS);
 
-	/* Fully update the flow */
-	p_ptr->update |= (PU_FORGET_FLOW | PU_UPDATE_FLOW);
+	/* Update the flow */
+	p_ptr->update |= (PU_UPDATE_FLOW);
 
 	/* Result */
 	return (TRUE);
@@ -1279,11 +1279,6 @@ void idle_update(void)
  */
 static void dungeon(struct cave *c)
 {
-	monster_type *m_ptr;
-	int i;
-
-
-
 	/* Hack -- enforce illegal panel */
 	Term->offset_y = DUNGEON_HGT;
 	Term->offset_x = DUNGEON_WID;
@@ -1515,26 +1510,7 @@ static void dungeon(struct cave *c)
 		p_ptr->energy += extract_energy[p_ptr->state.speed];
 
 		/* Give energy to all monsters */
-		for (i = cave_monster_max(cave) - 1; i >= 1; i--)
-		{
-			int mspeed;
-			
-			/* Access the monster */
-			m_ptr = cave_monster(cave, i);
-
-			/* Ignore "dead" monsters */
-			if (!m_ptr->r_idx) continue;
-
-			/* Calculate the net speed */
-			mspeed = m_ptr->mspeed;
-			if (m_ptr->m_timed[MON_TMD_FAST])
-				mspeed += 10;
-			if (m_ptr->m_timed[MON_TMD_SLOW])
-				mspeed -= 10;
-
-			/* Give this monster some energy */
-			m_ptr->energy += extract_energy[mspeed];
-		}
+		mon_sched_tick(c);
 
 		/* Count game turns */
 		turn++;
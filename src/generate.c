@@ -3504,6 +3504,9 @@ static void cave_clear(struct cave *c, struct player *p) {
 	/* Nothing good here yet */
 	c->mon_rating = 0;
 	c->obj_rating = 0;
+
+	/* Nothing is known about line of sight */
+	cave_forget_los(c);
 }
 
 /**
@@ -28,6 +28,7 @@
 #include "keymap.h"
 #include "init.h"
 #include "monster/init.h"
+#include "monster/mon-make.h"
 #include "monster/mon-msg.h"
 #include "monster/mon-util.h"
 #include "object/object.h"
@@ -3159,8 +3160,10 @@ void cleanup_angband(void)
 	free_obj_alloc();
 	FREE(alloc_ego_table);
 	FREE(alloc_race_table);
+	free_mon_alloc();
 
 	event_remove_all_handlers();
+	subwindows_free();
 
 	/* Free the stores */
 	if (stores) free_stores();
@@ -28,11 +28,19 @@
  * keypress and the action is stored as a string of keypresses, terminated
  * with a keypress with type == EVT_NONE.
  *
+ * Each mode keeps its keymaps in a list, newest first, which is the order
+ * keymap_dump() writes them in.  Every keymap is also chained into a hash
+ * table on its trigger, so that keymap_find() doesn't have to walk the whole
+ * list for every keypress it is asked about.
+ *
  * XXX We should note when we read in keymaps that are "official game" keymaps
  * and ones which are user-defined.  Then we can avoid writing out official
  * game ones and messing up everyone's pref files with a load of junk.
  */
 
+/** Number of hash chains for each keymap mode; must be a power of two. */
+#define KEYMAP_HASH_SIZE	1024
+
 
 /**
  * Struct for a keymap.
@@ -44,6 +52,7 @@ struct keymap {
 	bool user;		/* User-defined keymap */
 
 	struct keymap *next;
+	struct keymap *hash_next;	/* Next keymap in the same hash chain */
 };
 
 
@@ -52,6 +61,22 @@ struct keymap {
  */
 static struct keymap *keymaps[KEYMAP_MODE_MAX];
 
+/**
+ * Hash chains of keymaps, by trigger.
+ */
+static struct keymap *keymap_table[KEYMAP_MODE_MAX][KEYMAP_HASH_SIZE];
+
+
+/**
+ * Return the hash chain a trigger belongs in.
+ */
+static struct keymap **keymap_chain(int keymap, struct keypress kc)
+{
+	u32b hash = (kc.code ^ (u32b)kc.mods << 24) * 2654435761U;
+
+	return &keymap_table[keymap][hash >> 22 & (KEYMAP_HASH_SIZE - 1)];
+}
+
 
 /**
  * Find a keymap, given a keypress.
@@ -60,7 +85,7 @@ const struct keypress *keymap_find(int keymap, struct keypress kc)
 {
 	struct keymap *k;
 	assert(keymap >= 0 && keymap < KEYMAP_MODE_MAX);
-	for (k = keymaps[keymap]; k; k = k->next) {
+	for (k = *keymap_chain(keymap, kc); k; k = k->hash_next) {
 		if (k->key.code == kc.code && k->key.mods == kc.mods)
 			return k->actions;
 	}
@@ -98,6 +123,7 @@ static struct keypress *keymap_make(const struct keypress *actions)
 void keymap_add(int keymap, struct keypress trigger, struct keypress *actions, bool user)
 {
 	struct keymap *k = mem_zalloc(sizeof *k);
+	struct keymap **chain;
 	assert(keymap >= 0 && keymap < KEYMAP_MODE_MAX);
 
 	keymap_remove(keymap, trigger);
@@ -109,6 +135,10 @@ void keymap_add(int keymap, struct keypress trigger, struct keypress *actions, b
 	k->next = keymaps[keymap];
 	keymaps[keymap] = k;
 
+	chain = keymap_chain(keymap, trigger);
+	k->hash_next = *chain;
+	*chain = k;
+
 	return;
 }
 
@@ -119,24 +149,27 @@ void keymap_add(int keymap, struct keypress trigger, struct keypress *actions, b
 bool keymap_remove(int keymap, struct keypress trigger)
 {
 	struct keymap *k;
-	struct keymap *prev = NULL;
+	struct keymap **prev;
 	assert(keymap >= 0 && keymap < KEYMAP_MODE_MAX);
 
-	for (k = keymaps[keymap]; k; k = k->next) {
-		if (k->key.code == trigger.code && k->key.mods == trigger.mods) {
-			mem_free(k->actions);
-			if (prev)
-				prev->next = k->next;
-			else
-				keymaps[keymap] = k->next;
-			mem_free(k);
-			return TRUE;
-		}
-
-		prev = k;
+	/* Unhook it from its hash chain */
+	for (prev = keymap_chain(keymap, trigger); *prev; prev = &(*prev)->hash_next) {
+		if ((*prev)->key.code == trigger.code && (*prev)->key.mods == trigger.mods)
+			break;
 	}
 
-	return FALSE;
+	k = *prev;
+	if (!k) return FALSE;
+	*prev = k->hash_next;
+
+	/* And from the list */
+	for (prev = &keymaps[keymap]; *prev != k; prev = &(*prev)->next)
+		;
+	*prev = k->next;
+
+	mem_free(k->actions);
+	mem_free(k);
+	return TRUE;
 }
 
 
@@ -155,7 +188,11 @@ void keymap_free(void)
 			mem_free(k);
 			k = next;
 		}
+
+		keymaps[i] = NULL;
 	}
+
+	memset(keymap_table, 0, sizeof(keymap_table));
 }
 
 
@@ -1118,6 +1118,9 @@ int rd_monster_memory_2(void)
 		/* Repair the spell lore flags */
 		rsf_inter(l_ptr->spell_flags, r_ptr->spell_flags);
 	}
+
+	/* Some uniques may be dead */
+	get_mon_num_reset();
 	
 	return 0;
 }
@@ -1191,6 +1194,9 @@ int rd_monster_memory_1(void)
 		/* Repair the spell lore flags */
 		rsf_inter(l_ptr->spell_flags, r_ptr->spell_flags);
 	}
+
+	/* Some uniques may be dead */
+	get_mon_num_reset();
 	
 	return 0;
 }
@@ -1226,6 +1232,7 @@ int rd_object_memory(void)
 		if (tmp8u & 0x04) kind_squelch_when_aware(k_ptr);
 		if (tmp8u & 0x10) kind_squelch_when_unaware(k_ptr);
 	}
+	object_flags_forget(NULL);
 	
 	return 0;
 }
@@ -2226,6 +2233,9 @@ int rd_dungeon(void)
 		}
 	}
 
+	/* The "info" was loaded behind the back of the line of sight cache */
+	cave_forget_los(cave);
+
 
 	/*** Player ***/
 
@@ -48,11 +48,40 @@ extern bool borg_cheat_death;
 static bool wants_start_borg = FALSE;
 static int wants_start_borg_keypress_idx = 0;
 
+/*
+ * Number of int32 words used to describe a single cell in the frame buffer.
+ * The layout is shared with worker.ts and render.ts; keep them in sync.
+ *
+ *   word 0: FRAME_CELL_TEXT or FRAME_CELL_PICT
+ *   text:   word 1 = character, word 2 = RGB color
+ *   pict:   word 1 = graphics mode, words 2-3 = pict row/col,
+ *           words 4-5 = terrain row/col (or -1 for no terrain)
+ */
+#define FRAME_CELL_WORDS 6
+#define FRAME_CELL_TEXT 0
+#define FRAME_CELL_PICT 1
+
+/*
+ * A copy of the screen which lives in the wasm heap.
+ *
+ * The term hooks write into this rather than calling out to JS for every
+ * cell; on TERM_XTRA_FRESH the dirty rows are handed over in a single call.
+ */
+typedef struct frame_buffer {
+	int rows;
+	int cols;
+	int32_t *cells;         /* rows * cols * FRAME_CELL_WORDS */
+	uint32_t *dirty_rows;   /* Bitmap of rows changed since the last flush */
+	int cursor_row;         /* Cursor location, or -1 if hidden */
+	int cursor_col;
+} frame_buffer;
+
 /*
  * Information about a term
  */
 typedef struct term_data {
 	term t;                 /* All term info */
+	frame_buffer fb;        /* Cells waiting to be flushed */
 } term_data;
 
 /* Return an RGB color for a given attribute index. */
@@ -73,19 +102,90 @@ static void Term_init_emscripten(term *t) {
 }
 
 static void Term_nuke_emscripten(term *t) {
+	term_data *td = (term_data *)(t->data);
+	FREE(td->fb.cells);
+	FREE(td->fb.dirty_rows);
+}
+
+/*
+ * Return the frame buffer for the active term.
+ */
+static frame_buffer *active_frame(void) {
+	return &((term_data *)(Term->data))->fb;
+}
+
+/*
+ * Mark a row of the frame buffer as needing to be sent to the renderer.
+ */
+static void frame_mark_row(frame_buffer *fb, int row) {
+	fb->dirty_rows[row / 32] |= (1U << (row % 32));
+}
+
+/*
+ * Return the frame buffer words for the cell at (row, col).
+ */
+static int32_t *frame_cell(frame_buffer *fb, int row, int col) {
+	return &fb->cells[(row * fb->cols + col) * FRAME_CELL_WORDS];
+}
+
+/*
+ * Store a text cell. Like the renderer, any drawing hides the cursor.
+ */
+static void frame_set_text(frame_buffer *fb, int row, int col, wchar_t c, uint32_t rgb) {
+	int32_t *cell = frame_cell(fb, row, col);
+	cell[0] = FRAME_CELL_TEXT;
+	cell[1] = c;
+	cell[2] = (int32_t)rgb;
+	cell[3] = cell[4] = cell[5] = 0;
+	fb->cursor_row = fb->cursor_col = -1;
+}
+
+/*
+ * Store a tile cell, hiding the cursor just as text does.
+ */
+static void frame_set_pict(frame_buffer *fb, int row, int col, int graf_id,
+		int pict_row, int pict_col, int terr_row, int terr_col) {
+	int32_t *cell = frame_cell(fb, row, col);
+	cell[0] = FRAME_CELL_PICT;
+	cell[1] = graf_id;
+	cell[2] = pict_row;
+	cell[3] = pict_col;
+	cell[4] = terr_row;
+	cell[5] = terr_col;
+	fb->cursor_row = fb->cursor_col = -1;
+}
+
+/*
+ * Blank every cell in the frame buffer and mark it all dirty.
+ */
+static void frame_clear(frame_buffer *fb) {
+	int row, col;
+	for (row = 0; row < fb->rows; row++) {
+		for (col = 0; col < fb->cols; col++) {
+			frame_set_text(fb, row, col, ' ', 0);
+		}
+		frame_mark_row(fb, row);
+	}
+}
+
+/*
+ * Send the dirty rows of the frame buffer to the renderer in one go.
+ */
+static void frame_flush(frame_buffer *fb) {
+	EM_ASM({
+		ANGBAND.drawFrame(HEAP32, $0, $1, $2, $3, $4, $5);
+	}, fb->cells, fb->dirty_rows, fb->rows, fb->cols, fb->cursor_row, fb->cursor_col);
+	memset(fb->dirty_rows, 0, ((fb->rows + 31) / 32) * sizeof(uint32_t));
 }
 
 static errr Term_text_emscripten(int x, int y, int n, byte a, const wchar_t *s) {
+	frame_buffer *fb = active_frame();
 	uint32_t color = rgb_from_table_index(a);
 	for (int i=0; i < n; i++) {
-		int row = y;
-		int col = x + i;
-		wchar_t c = s[i];
-		EM_ASM({
-			ANGBAND.setCell($0, $1, $2, $3);
-		}, row, col, c, color);
 		// TODO: "the high bit of the attribute indicates a reversed fg/bg"?
+		frame_set_text(fb, y, x + i, s[i], color);
 	}
+	frame_mark_row(fb, y);
 	return 0;
 }
 
@@ -93,9 +193,10 @@ static errr Term_pict_emscripten(int x, int y, int n, const byte *ap,
                             const wchar_t *cp, const byte *tap,
                             const wchar_t *tcp)
 {
+	frame_buffer *fb = active_frame();
 	int row = y;
 	int col = x;
-	for (int i = 0; i < n; i++)
+	for (int i = 0; i < n; i++, col++)
 	{
         byte a = *ap++;
         wchar_t c = *cp++;        
@@ -112,9 +213,9 @@ static errr Term_pict_emscripten(int x, int y, int n, const byte *ap,
             int terr_row = draw_terrain ? ((byte)ta & 0x7F) : -1;
             int terr_col = draw_terrain ? ((byte)tc & 0x7F) : -1;
 
-			EM_ASM({
-				ANGBAND.setCellPict($0, $1, $2, $3, $4, $5, $6);
-			}, row, col, current_graphics_mode->grafID, pict_row, pict_col, terr_row, terr_col);
+			frame_set_pict(fb, row, col, current_graphics_mode->grafID,
+				pict_row, pict_col, terr_row, terr_col);
+			frame_mark_row(fb, row);
 		}
 	}
 	return 0;
@@ -163,9 +264,9 @@ static void check_graphics_changes()
  * "Move" the "hardware" cursor.
  */
 static errr Term_curs_emscripten(int x, int y) {
-	EM_ASM({
-		ANGBAND.setCursor($0, $1, $2);
-	}, y, x);
+	frame_buffer *fb = active_frame();
+	fb->cursor_row = y;
+	fb->cursor_col = x;
 	return 0;
 }
 
@@ -174,9 +275,11 @@ static errr Term_curs_emscripten(int x, int y) {
  * Erase a grid of space
  */
 static errr Term_wipe_emscripten(int x, int y, int n) {
-	EM_ASM({
-		ANGBAND.wipeCells($0, $1, $2);
-	}, y, x, n);
+	frame_buffer *fb = active_frame();
+	for (int i = 0; i < n; i++) {
+		frame_set_text(fb, y, x + i, ' ', 0);
+	}
+	if (n > 0) frame_mark_row(fb, y);
 	return 0;
 }
 
@@ -191,6 +294,33 @@ EM_JS(void, emscripten_file_sync, (), {
 	ANGBAND.fsync();
 });
 
+#ifdef WASM_SHARED_INPUT
+
+/*
+ * Tell worker.ts that input arrives through its SharedArrayBuffer ring,
+ * so the worker must never need its own event loop once main() runs.
+ */
+EMSCRIPTEN_KEEPALIVE int angband_shared_input(void);
+int angband_shared_input(void) {
+	return 1;
+}
+
+/*
+ * Wait for an event, optionally blocking in Atomics.wait().
+ */
+EM_JS(int, emscripten_gather_event, (int wait), {
+	return ANGBAND.gatherEventNow(wait);
+});
+
+/*
+ * Sleep for a number of milliseconds, still picking up input.
+ */
+EM_JS(void, emscripten_delay, (int ms), {
+	ANGBAND.sleep(ms);
+});
+
+#else /* WASM_SHARED_INPUT */
+
 /*
  * Wait for an event, optionally blocking.
  */
@@ -198,6 +328,15 @@ EM_ASYNC_JS(int, emscripten_gather_event, (int wait), {
 	return ANGBAND.gatherEvent(wait);
 });
 
+/*
+ * Sleep for a number of milliseconds, yielding to the worker.
+ */
+static void emscripten_delay(int ms) {
+	emscripten_sleep(ms);
+}
+
+#endif /* WASM_SHARED_INPUT */
+
 /*
  * Return true if we have an event ready to go.
  */
@@ -289,13 +428,12 @@ static bool Term_xtra_emscripten_event(int wait)
  */
 static errr Term_xtra_emscripten(int n, int v) {
 	term_data *td = (term_data *)(Term->data);
-	(void)td;
 
 	/* Analyze the request */
 	switch (n) {
 		/* Clear screen */
 		case TERM_XTRA_CLEAR:
-			EM_ASM({ ANGBAND.clearScreen(); });
+			frame_clear(&td->fb);
 			return 0;
 
 		/* Make a noise */
@@ -305,7 +443,7 @@ static errr Term_xtra_emscripten(int n, int v) {
 
 		/* Flush the drawing buffer */
 		case TERM_XTRA_FRESH:
-			EM_ASM({ ANGBAND.flushDrawing(); });
+			frame_flush(&td->fb);
 			return 0;
 
 		/* Change the cursor visibility */
@@ -327,7 +465,7 @@ static errr Term_xtra_emscripten(int n, int v) {
 
 		/* Delay */
 		case TERM_XTRA_DELAY:
-			if (v > 0 && !emscripten_turbo()) emscripten_sleep(v);
+			if (v > 0 && !emscripten_turbo()) emscripten_delay(v);
 			return 0;
 
 		/* React to events */
@@ -349,6 +487,13 @@ static errr term_data_init_emscripten(term_data *td, int rows, int cols, int y,
 	/* Initialize the term */
 	term_init(t, cols, rows, 256);
 
+	/* Allocate the frame buffer, starting out blank */
+	td->fb.rows = rows;
+	td->fb.cols = cols;
+	td->fb.cells = C_ZNEW(rows * cols * FRAME_CELL_WORDS, int32_t);
+	td->fb.dirty_rows = C_ZNEW((rows + 31) / 32, uint32_t);
+	frame_clear(&td->fb);
+
 	/* Erase with "white space" */
 	t->attr_blank = TERM_WHITE;
 	t->char_blank = ' ';
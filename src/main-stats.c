@@ -30,6 +30,8 @@
 #include "stats/structs.h"
 #include <stddef.h>
 #include <time.h>
+#include <sys/types.h>
+#include <sys/wait.h>
 
 #define OBJ_FEEL_MAX	 11
 #define MON_FEEL_MAX 	 10
@@ -50,6 +52,8 @@
 static int randarts = 0;
 static int no_selling = 0;
 static u32b num_runs = 1;
+static u32b num_workers = 1;
+static u32b base_seed = 0;
 static bool quiet = FALSE;
 static int nextkey = 0;
 static int running_stats = 0;
@@ -58,6 +62,11 @@ static char *ANGBAND_DIR_STATS;
 static int *consumables_index;
 static int *wearables_index;
 static int *pval_flags_index;
+
+/* The inverses of the above, e.g. wearables_kind[wearables_index[k]] == k */
+static int *consumables_kind;
+static int *wearables_kind;
+static int *pval_flags_flag;
 static int wearable_count = 0;
 static int consumable_count = 0;
 static int pval_flags_count = 0;
@@ -72,6 +81,9 @@ struct wearables_data {
 	u32b *egos;
 	u32b flags[OF_MAX];
 	u32b *pval_flags[TOP_PVAL];
+
+	/* Changed since the last write to the database */
+	bool dirty;
 };
 
 static struct level_data {
@@ -112,6 +124,22 @@ static void create_indices()
 	for (i = 0; i < OF_MAX; i++)
 		if (flag_uses_pval(i))
 			pval_flags_index[i] = ++pval_flags_count;
+
+	consumables_kind = C_ZNEW(consumable_count + 1, int);
+	wearables_kind = C_ZNEW(wearable_count + 1, int);
+	pval_flags_flag = C_ZNEW(pval_flags_count + 1, int);
+
+	for (i = 0; i < z_info->k_max; i++) {
+		consumables_kind[consumables_index[i]] = i;
+		wearables_kind[wearables_index[i]] = i;
+	}
+
+	/* Index 0 is shared by everything unindexed; it stands for kind 0 */
+	consumables_kind[0] = wearables_kind[0] = 0;
+
+	for (i = 0; i < OF_MAX; i++)
+		pval_flags_flag[pval_flags_index[i]] = i;
+	pval_flags_flag[0] = 0;
 }
 
 static void alloc_memory()
@@ -135,6 +163,9 @@ static void alloc_memory()
 				for (l = 0; l < TOP_PVAL; l++)
 					level_data[i].wearables[j][k].pval_flags[l]
 						= C_ZNEW(pval_flags_count + 1, u32b);
+
+				/* Nothing has been written yet */
+				level_data[i].wearables[j][k].dirty = TRUE;
 			}
 		}
 	}
@@ -162,6 +193,9 @@ static void free_stats_memory(void)
 	mem_free(consumables_index);
 	mem_free(wearables_index);
 	mem_free(pval_flags_index);
+	mem_free(consumables_kind);
+	mem_free(wearables_kind);
+	mem_free(pval_flags_flag);
 	string_free(ANGBAND_DIR_STATS);
 }
 
@@ -204,16 +238,15 @@ static void generate_player_for_stats()
 	p_ptr->sc_birth = p_ptr->sc;
 }
 
-static void initialize_character(void)
+static void initialize_character(u32b seed)
 {
-	u32b seed;
+	int i;
 
 	if (!quiet) {
 		printf(" [I  ]\b\b\b\b\b\b");
 		fflush(stdout);
 	}
 
-	seed = (time(NULL));
 	Rand_quick = FALSE;
 	Rand_state_init(seed);
 
@@ -229,6 +262,10 @@ static void initialize_character(void)
 		do_randart(seed_randart, TRUE);
 	}
 
+	/* Forget the last run's shopkeepers, so the shuffle draws the same */
+	for (i = 0; i < MAX_STORES; i++)
+		stores[i].owner = NULL;
+
 	store_reset();
 	flavor_init();
 	p_ptr->playing = TRUE;
@@ -251,6 +288,8 @@ static void kill_all_monsters(int level)
 		if (rf_has(r_ptr->flags, RF_UNIQUE))
 			r_ptr->max_num = 0;
 	}
+
+	get_mon_num_reset();
 }
 
 static void unkill_uniques(void)
@@ -268,6 +307,8 @@ static void unkill_uniques(void)
 		if (rf_has(r_ptr->flags, RF_UNIQUE))
 			r_ptr->max_num = 1;
 	}
+
+	get_mon_num_reset();
 }
 
 static void reset_artifacts(void)
@@ -313,6 +354,7 @@ static void log_all_objects(int level)
 					struct wearables_data *w
 						= &level_data[level].wearables[o_ptr->origin][wearables_index[o_ptr->kind->kidx]];
 
+					w->dirty = TRUE;
 					w->count++;
 					w->dice[MIN(o_ptr->dd, TOP_DICE - 1)][MIN(o_ptr->ds, TOP_SIDES - 1)]++;
 					w->ac[MIN(MAX(o_ptr->ac + o_ptr->to_a, 0), TOP_AC - 1)]++;
@@ -1221,22 +1263,10 @@ static int stats_wearables_data_offsetof(const char *member)
 }
 
 /**
- * Given a pointer to a dynamically allocated array and a value, look up
- * the index with that value; e.g. given wearables_index[k_idx], return k_idx.
- * If not found, return -1 * value.
+ * Write the non-zero cells of level_data[level].<table>. Rows go through
+ * the table's UNIQUE constraint, which replaces the row from the previous
+ * checkpoint.
  */
-
-static int stats_lookup_index(const int *index, int max_idx, int value)
-{
-	int idx;
-
-	for (idx = 0; idx < max_idx; idx ++) {
-		if (index[idx] == value) return idx;
-	}
-
-	return -1 * value;
-}
-
 static int stats_write_db_level_data(const char *table, int max_idx)
 {
 	char sql_buf[256];
@@ -1244,7 +1274,7 @@ static int stats_write_db_level_data(const char *table, int max_idx)
 	int err, level, i, offset;
 
 	strnfmt(sql_buf, 256, "INSERT INTO %s VALUES(?,?,?);", table);
-	err = stats_db_stmt_prep(&sql_stmt, sql_buf);
+	err = stats_db_stmt_cached(&sql_stmt, sql_buf);
 	if (err) return err;
 
 	offset = stats_level_data_offsetof(table);
@@ -1255,26 +1285,33 @@ static int stats_write_db_level_data(const char *table, int max_idx)
 		{
 			/* This arcane expression finds the value of 
 			 * level_data[level].<table>[i] */
-			u32b count;
+			long long count;
 			if (streq(table, "gold"))
 			{
 				count = *((long long *)((byte *)&level_data[level] + offset) + i);
 			}
+			else if (streq(table, "monsters"))
+			{
+				count = (*(u32b **)((byte *)&level_data[level] + offset))[i];
+			}
 			else
 			{
 				count = *((u32b *)((byte *)&level_data[level] + offset) + i);
 			}
 			if (!count) continue;
 
-			err = stats_db_bind_ints(sql_stmt, 3, 0,
-				level, count, i);
+			err = stats_db_bind_ints(sql_stmt, 1, 0, level);
+			if (err) return err;
+			err = sqlite3_bind_int64(sql_stmt, 2, count);
+			if (err) return err;
+			err = stats_db_bind_ints(sql_stmt, 1, 2, i);
 			if (err) return err;
 
 			STATS_DB_STEP_RESET(sql_stmt)
 		}
 	}
 
-	return sqlite3_finalize(sql_stmt);
+	return SQLITE_OK;
 }
 
 static int stats_write_db_level_data_items(const char *table, int max_idx, 
@@ -1285,7 +1322,7 @@ static int stats_write_db_level_data_items(const char *table, int max_idx,
 	int err, level, origin, i, offset;
 
 	strnfmt(sql_buf, 256, "INSERT INTO %s VALUES(?,?,?,?);", table);
-	err = stats_db_stmt_prep(&sql_stmt, sql_buf);
+	err = stats_db_stmt_cached(&sql_stmt, sql_buf);
 	if (err) return err;
 
 	offset = stats_level_data_offsetof(table);
@@ -1303,7 +1340,7 @@ static int stats_write_db_level_data_items(const char *table, int max_idx,
 
 				err = stats_db_bind_ints(sql_stmt, 4, 0,
 					level, count, 
-					translate_consumables ? stats_lookup_index(consumables_index, z_info->k_max, i) : i, origin);
+					translate_consumables ? consumables_kind[i] : i, origin);
 				if (err) return err;
 
 				STATS_DB_STEP_RESET(sql_stmt)
@@ -1311,7 +1348,7 @@ static int stats_write_db_level_data_items(const char *table, int max_idx,
 		}
 	}
 
-	return sqlite3_finalize(sql_stmt);
+	return SQLITE_OK;
 }
 
 static int stats_write_db_wearables_count(void)
@@ -1319,7 +1356,7 @@ static int stats_write_db_wearables_count(void)
 	sqlite3_stmt *sql_stmt;
 	int err, level, origin, k_idx, idx;
 
-	err = stats_db_stmt_prep(&sql_stmt, 
+	err = stats_db_stmt_cached(&sql_stmt, 
 		"INSERT INTO wearables_count VALUES(?,?,?,?);");
 	if (err) return err;
 
@@ -1329,18 +1366,21 @@ static int stats_write_db_wearables_count(void)
 		{
 			for (idx = 0; idx < wearable_count + 1; idx++)
 			{
-				u32b count = level_data[level].wearables[origin][idx].count;
+				struct wearables_data *w = &level_data[level].wearables[origin][idx];
+
+				/* Skip if unchanged since the last write */
+				if (!w->dirty) continue;
+
 				/* Skip if object did not appear */
-				if (!count) continue;
+				if (!w->count) continue;
 
-				k_idx = stats_lookup_index(wearables_index, 
-					z_info->k_max, idx);
+				k_idx = wearables_kind[idx];
 
 				/* Skip if pile */
 				if (! k_idx) continue;
 
 				err = stats_db_bind_ints(sql_stmt, 4, 0,
-					level, count, k_idx, origin);
+					level, w->count, k_idx, origin);
 				if (err) return err;
 
 				STATS_DB_STEP_RESET(sql_stmt)
@@ -1348,7 +1388,7 @@ static int stats_write_db_wearables_count(void)
 		}
 	}
 
-	return sqlite3_finalize(sql_stmt);
+	return SQLITE_OK;
 }
 
 /**
@@ -1364,7 +1404,7 @@ static int stats_write_db_wearables_array(const char *field, int max_val, bool a
 	int err, level, origin, idx, k_idx, i, offset;
 
 	strnfmt(sql_buf, 256, "INSERT INTO wearables_%s VALUES(?,?,?,?,?);", field);
-	err = stats_db_stmt_prep(&sql_stmt, sql_buf);
+	err = stats_db_stmt_cached(&sql_stmt, sql_buf);
 	if (err) return err;
 
 	offset = stats_wearables_data_offsetof(field);
@@ -1375,8 +1415,11 @@ static int stats_write_db_wearables_array(const char *field, int max_val, bool a
 		{
 			for (idx = 0; idx < wearable_count + 1; idx++)
 			{
-				k_idx = stats_lookup_index(wearables_index, 
-					z_info->k_max, idx);
+				/* Skip if unchanged since the last write */
+				if (!level_data[level].wearables[origin][idx].dirty)
+					continue;
+
+				k_idx = wearables_kind[idx];
 
 				/* Skip if pile */
 				if (! k_idx) continue;
@@ -1406,7 +1449,7 @@ static int stats_write_db_wearables_array(const char *field, int max_val, bool a
 		}
 	}
 
-	return sqlite3_finalize(sql_stmt);
+	return SQLITE_OK;
 }
 
 /**
@@ -1423,7 +1466,7 @@ static int stats_write_db_wearables_2d_array(const char *field,
 	int err, level, origin, idx, k_idx, i, j, offset;
 
 	strnfmt(sql_buf, 256, "INSERT INTO wearables_%s VALUES(?,?,?,?,?,?);", field);
-	err = stats_db_stmt_prep(&sql_stmt, sql_buf);
+	err = stats_db_stmt_cached(&sql_stmt, sql_buf);
 	if (err) return err;
 
 	offset = stats_wearables_data_offsetof(field);
@@ -1434,8 +1477,11 @@ static int stats_write_db_wearables_2d_array(const char *field,
 		{
 			for (idx = 0; idx < wearable_count + 1; idx++)
 			{
-				k_idx = stats_lookup_index(wearables_index, 
-					z_info->k_max, idx);
+				/* Skip if unchanged since the last write */
+				if (!level_data[level].wearables[origin][idx].dirty)
+					continue;
+
+				k_idx = wearables_kind[idx];
 
 				/* Skip if pile */
 				if (! k_idx) continue;
@@ -1447,7 +1493,7 @@ static int stats_write_db_wearables_2d_array(const char *field,
 						/* This arcane expression finds the value of
 				 		* level_data[level].wearables[origin][idx].<field>[i][j] */
 						u32b count;
-						int real_j = translate_pval_flags ? stats_lookup_index(pval_flags_index, OF_MAX, j) : j; 
+						int real_j = translate_pval_flags ? pval_flags_flag[j] : j; 
 
 						if (i == 0 && real_j == 0) continue;
 
@@ -1473,18 +1519,32 @@ static int stats_write_db_wearables_2d_array(const char *field,
 		}
 	}
 
-	return sqlite3_finalize(sql_stmt);
+	return SQLITE_OK;
 }
 
-static int stats_write_db(u32b run)
+/**
+ * Mark every wearables row as written, after a successful checkpoint.
+ */
+static void stats_clean_wearables(void)
+{
+	int level, origin, idx;
+
+	for (level = 0; level < LEVEL_MAX; level++)
+		for (origin = 0; origin < ORIGIN_STATS; origin++)
+			for (idx = 0; idx < wearable_count + 1; idx++)
+				level_data[level].wearables[origin][idx].dirty = FALSE;
+}
+
+/**
+ * Write the counters to the database as one transaction. Only the wearables
+ * rows that changed since the last call are rewritten; the per-level tables
+ * change every run, so they are written whole, less their zero cells.
+ */
+static int stats_write_db_counters(u32b run)
 {
 	char sql_buf[256];
 	int err;
 
-	/* Wrap entire write into a transaction */
-	err = stats_db_exec("BEGIN TRANSACTION;");
-	if (err) return err;
-
 	strnfmt(sql_buf, 256, 
 		"INSERT OR REPLACE INTO metadata VALUES('runs', %d);", run);
 	err = stats_db_exec(sql_buf);
@@ -1534,10 +1594,22 @@ static int stats_write_db(u32b run)
 	err = stats_write_db_wearables_2d_array("pval_flags", TOP_PVAL, pval_flags_count + 1, false, true);
 	if (err) return err;
 
-	/* Commit transaction */
-	err = stats_db_exec("COMMIT;");
+	return SQLITE_OK;
+}
+
+static int stats_write_db(u32b run)
+{
+	int err;
+
+	/* Wrap entire write into a transaction */
+	err = stats_db_batch_begin();
+	if (err) return err;
+
+	err = stats_db_batch_commit(stats_write_db_counters(run));
 	if (err) return err;
 
+	stats_clean_wearables();
+
 	return SQLITE_OK;
 }
 
@@ -1572,17 +1644,263 @@ void progress_bar(u32b run, time_t start) {
  * Clean up memory after each run. Should only affect character and
  * dungeon structs allocated during normal initialization, not persistent 
  * data like *_info.
+ *
+ * The last level is wiped here rather than by the next run's first
+ * cave_generate(), which would otherwise knock the monster race counts that
+ * player_init() has just reset below zero and make the next run depend on
+ * this one.
  */
 
 static void stats_cleanup_angband_run(void)
 {
+	wipe_o_list(cave);
+	wipe_mon_list(cave, p_ptr);
 	if (p_ptr->history) FREE(p_ptr->history);
 }
 
+/**
+ * Make a single run through the dungeon. Each run is seeded from its number,
+ * so a given run produces the same results whichever process makes it.
+ */
+static void stats_do_run(u32b run, artifact_type *a_info_save)
+{
+	unsigned int i;
+
+	if (randarts)
+	{
+		for (i = 0; i < z_info->a_max; i++)
+		{
+			memcpy(&a_info[i], &a_info_save[i], sizeof(artifact_type));
+		}
+	}
+
+	initialize_character(base_seed + run - 1);
+	unkill_uniques();
+	reset_artifacts();
+	descend_dungeon();
+	stats_cleanup_angband_run();
+}
+
+/**
+ * Function called on each array of counters in level_data. `wide` is set
+ * for arrays of long long rather than u32b.  Returns false on failure.
+ */
+typedef bool (*stats_counter_func)(ang_file *f, void *counts, int n,
+	bool wide);
+
+/**
+ * Call func on every array of counters in level_data, in a fixed order.
+ */
+static bool stats_walk_counters(stats_counter_func func, ang_file *f)
+{
+	int level, origin, idx, i;
+
+	for (level = 0; level < LEVEL_MAX; level++)
+	{
+		struct level_data *ld = &level_data[level];
+
+		if (!func(f, ld->monsters, z_info->r_max, FALSE)) return FALSE;
+		if (!func(f, ld->obj_feelings, OBJ_FEEL_MAX, FALSE)) return FALSE;
+		if (!func(f, ld->mon_feelings, MON_FEEL_MAX, FALSE)) return FALSE;
+		if (!func(f, ld->gold, ORIGIN_STATS, TRUE)) return FALSE;
+
+		for (origin = 0; origin < ORIGIN_STATS; origin++)
+		{
+			if (!func(f, ld->artifacts[origin], z_info->a_max, FALSE))
+				return FALSE;
+			if (!func(f, ld->consumables[origin], consumable_count + 1, FALSE))
+				return FALSE;
+
+			for (idx = 0; idx < wearable_count + 1; idx++)
+			{
+				struct wearables_data *w = &ld->wearables[origin][idx];
+
+				if (!func(f, &w->count, 1, FALSE)) return FALSE;
+				if (!func(f, w->dice, TOP_DICE * TOP_SIDES, FALSE)) return FALSE;
+				if (!func(f, w->ac, TOP_AC, FALSE)) return FALSE;
+				if (!func(f, w->hit, TOP_PLUS, FALSE)) return FALSE;
+				if (!func(f, w->dam, TOP_PLUS, FALSE)) return FALSE;
+				if (!func(f, w->egos, z_info->e_max, FALSE)) return FALSE;
+				if (!func(f, w->flags, OF_MAX, FALSE)) return FALSE;
+
+				for (i = 0; i < TOP_PVAL; i++)
+					if (!func(f, w->pval_flags[i], pval_flags_count + 1, FALSE))
+						return FALSE;
+			}
+		}
+	}
+
+	return TRUE;
+}
+
+/**
+ * Write the non-zero entries of an array of counters to a shard file, as a
+ * count followed by (index, value) pairs.
+ */
+static bool stats_shard_write_counters(ang_file *f, void *counts, int n,
+	bool wide)
+{
+	u32b nonzero = 0;
+	u32b i;
+
+	for (i = 0; i < (u32b)n; i++)
+		if (wide ? ((long long *)counts)[i] : ((u32b *)counts)[i])
+			nonzero++;
+
+	if (!file_write(f, (char *)&nonzero, sizeof(nonzero))) return FALSE;
+
+	for (i = 0; i < (u32b)n && nonzero; i++)
+	{
+		long long value = wide ? ((long long *)counts)[i] : ((u32b *)counts)[i];
+		if (!value) continue;
+
+		if (!file_write(f, (char *)&i, sizeof(i))) return FALSE;
+		if (!file_write(f, (char *)&value, sizeof(value))) return FALSE;
+		nonzero--;
+	}
+
+	return TRUE;
+}
+
+/**
+ * Read an array of counters written by stats_shard_write_counters() and add
+ * it into ours.
+ */
+static bool stats_shard_merge_counters(ang_file *f, void *counts, int n,
+	bool wide)
+{
+	u32b nonzero, i;
+
+	if (file_read(f, (char *)&nonzero, sizeof(nonzero)) != sizeof(nonzero))
+		return FALSE;
+
+	while (nonzero--)
+	{
+		long long value;
+
+		if (file_read(f, (char *)&i, sizeof(i)) != sizeof(i)) return FALSE;
+		if (file_read(f, (char *)&value, sizeof(value)) != sizeof(value))
+			return FALSE;
+		if (i >= (u32b)n) return FALSE;
+
+		if (wide)
+			((long long *)counts)[i] += value;
+		else
+			((u32b *)counts)[i] += (u32b)value;
+	}
+
+	return TRUE;
+}
+
+static void stats_shard_path(char *buf, size_t len, u32b worker)
+{
+	char leaf[32];
+
+	strnfmt(leaf, sizeof(leaf), "shard-%d.tmp", worker);
+	path_build(buf, len, ANGBAND_DIR_STATS, leaf);
+}
+
+/**
+ * Make runs first to last in a forked worker, then dump our counters into
+ * a shard file for the parent to merge. Never returns.
+ */
+static void stats_run_worker(u32b worker, u32b first, u32b last,
+	artifact_type *a_info_save)
+{
+	char path[1024];
+	ang_file *f;
+	bool ok;
+	bool report = !quiet;
+	u32b run;
+
+	/* Workers share the terminal, so leave progress to the parent */
+	quiet = TRUE;
+
+	for (run = first; run <= last; run++)
+		stats_do_run(run, a_info_save);
+
+	stats_shard_path(path, sizeof(path), worker);
+	f = file_open(path, MODE_WRITE, FTYPE_RAW);
+	ok = f && stats_walk_counters(stats_shard_write_counters, f);
+	if (f) ok = file_close(f) && ok;
+
+	if (report) {
+		printf("Worker %d finished runs %d-%d.\n", worker, first, last);
+		fflush(stdout);
+	}
+
+	/* Skip the parent's exit handlers */
+	_exit(ok ? 0 : 1);
+}
+
+/**
+ * Split the runs between num_workers forked processes, wait for them all,
+ * and add their counters into level_data.
+ *
+ * The game's global state rules out threads, but each child gets its own
+ * copy of it (and of the zeroed level_data) from fork().  Since every run is
+ * seeded from its number, the totals match a serial run.
+ */
+static void stats_run_parallel(artifact_type *a_info_save)
+{
+	pid_t *pids = C_ZNEW(num_workers, pid_t);
+	u32b worker, first = 1;
+	bool status;
+
+	/* The database is only ever touched by the parent, but is set up
+	 * before forking so that a failure leaves no workers behind; they
+	 * leave by _exit() and never use the inherited connection */
+	if (!quiet) printf("Creating the database and dumping info...\n");
+	status = stats_prep_db();
+	if (!status) quit("Couldn't prepare database!");
+
+	if (!quiet) {
+		printf("Beginning %d runs in %d workers...\n", num_runs, num_workers);
+	}
+	fflush(stdout);
+
+	for (worker = 0; worker < num_workers; worker++)
+	{
+		/* Spread any remainder over the first few workers */
+		u32b share = num_runs / num_workers + (worker < num_runs % num_workers);
+		u32b last = first + share - 1;
+
+		pids[worker] = fork();
+		if (pids[worker] < 0)
+			quit("Couldn't fork stats worker!");
+		if (pids[worker] == 0)
+			stats_run_worker(worker, first, last, a_info_save);
+
+		first = last + 1;
+	}
+
+	for (worker = 0; worker < num_workers; worker++)
+	{
+		char path[1024];
+		ang_file *f;
+		int wstatus;
+		bool ok;
+
+		if (waitpid(pids[worker], &wstatus, 0) < 0 ||
+				!WIFEXITED(wstatus) || WEXITSTATUS(wstatus))
+			quit_fmt("Stats worker %d failed!", worker);
+
+		stats_shard_path(path, sizeof(path), worker);
+		f = file_open(path, MODE_READ, FTYPE_RAW);
+		if (!f) quit_fmt("Couldn't open stats shard %d!", worker);
+		ok = stats_walk_counters(stats_shard_merge_counters, f);
+		file_close(f);
+		file_delete(path);
+		if (!ok) quit_fmt("Couldn't read stats shard %d!", worker);
+	}
+
+	mem_free(pids);
+}
+
 static errr run_stats(void)
 {
 	u32b run;
-	artifact_type *a_info_save;
+	artifact_type *a_info_save = NULL;
 	unsigned int i;
 	int err;
 	bool status; 
@@ -1603,58 +1921,54 @@ static errr run_stats(void)
 		}
 	}
 
-	if (!quiet) printf("Creating the database and dumping info...\n");
-	status = stats_prep_db();
-	if (!status) quit("Couldn't prepare database!");
-
-	if (!quiet) {
-		printf("Beginning %d runs...\n", num_runs);
-		fflush(stdout);
+	if (num_workers > 1)
+	{
+		stats_run_parallel(a_info_save);
 	}
-
-	start = time(NULL);
-	for (run = 1; run <= num_runs; run++)
+	else
 	{
-		if (!quiet) progress_bar(run - 1, start);
+		if (!quiet) printf("Creating the database and dumping info...\n");
+		status = stats_prep_db();
+		if (!status) quit("Couldn't prepare database!");
 
-		if (randarts)
-		{
-			for (i = 0; i < z_info->a_max; i++)
-			{
-				memcpy(&a_info[i], &a_info_save[i], sizeof(artifact_type));
-			}
+		if (!quiet) {
+			printf("Beginning %d runs...\n", num_runs);
+			fflush(stdout);
 		}
 
-		initialize_character();
-		unkill_uniques();
-		reset_artifacts();
-		descend_dungeon();
-		stats_cleanup_angband_run();
-
-		/* Checkpoint every so many runs */
-		if (run % RUNS_PER_CHECKPOINT == 0)
+		start = time(NULL);
+		for (run = 1; run <= num_runs; run++)
 		{
-			err = stats_write_db(run);
-			if (err)
+			if (!quiet) progress_bar(run - 1, start);
+
+			stats_do_run(run, a_info_save);
+
+			/* Checkpoint every so many runs */
+			if (run % RUNS_PER_CHECKPOINT == 0)
 			{
-				stats_db_close();
-				quit_fmt("Problems writing to database!  sqlite3 errno %d.", err);
+				err = stats_write_db(run);
+				if (err)
+				{
+					stats_db_close();
+					quit_fmt("Problems writing to database!  sqlite3 errno %d.", err);
+				}
 			}
-		}
 
-		if (quiet && run % 1000 == 0) {
-			printf("Finished %d runs.\n", run);
-			fflush(stdout);
+			if (quiet && run % 1000 == 0) {
+				printf("Finished %d runs.\n", run);
+				fflush(stdout);
+			}
 		}
+
+		if (!quiet) progress_bar(num_runs, start);
 	}
 
 	if (!quiet) {
-		progress_bar(num_runs, start);
 		printf("\nSaving the data...\n");
 		fflush(stdout);
 	}
 
-	err = stats_write_db(run);
+	err = stats_write_db(num_runs);
 	stats_db_close();
 	if (err) quit_fmt("Problems writing to database!  sqlite3 errno %d.", err);
 	free_stats_memory();
@@ -1786,22 +2100,26 @@ static void term_data_link(int i) {
 	angband_term[i] = t;
 }
 
-const char help_stats[] = "Stats mode, subopts -q(uiet) -r(andarts) -n(# of runs) -s(no selling)";
+const char help_stats[] = "Stats mode, subopts -q(uiet) -r(andarts) -n(# of runs) -s(no selling) -j(# of workers) -S(eed)";
 
 /*
  * Usage:
  *
- * angband -mstats -- [-q] [-r] [-nNNNN] [-s]
+ * angband -mstats -- [-q] [-r] [-nNNNN] [-s] [-jNN] [-SNNNN]
  *
  *   -q      Quiet mode (turn off progress messages)
  *   -r      Turn on randarts
  *   -nNNNN  Make NNNN runs through the dungeon (default: 1)
  *   -s      Turn on no-selling
+ *   -jNN    Split the runs between NN worker processes (default: 1)
+ *   -SNNNN  Seed run N with NNNN + N - 1 (default: the current time)
  */
 
 errr init_stats(int argc, char *argv[]) {
 	int i;
 
+	base_seed = time(NULL);
+
 	/* Skip over argv[0] */
 	for (i = 1; i < argc; i++) {
 		if (streq(argv[i], "-r")) {
@@ -1820,6 +2138,14 @@ errr init_stats(int argc, char *argv[]) {
 			no_selling = 1;
 			continue;
 		}
+		if (prefix(argv[i], "-j")) {
+			num_workers = MAX(atoi(&argv[i][2]), 1);
+			continue;
+		}
+		if (prefix(argv[i], "-S")) {
+			base_seed = strtoul(&argv[i][2], NULL, 10);
+			continue;
+		}
 		printf("init-stats: bad argument '%s'\n", argv[i]);
 	}
 
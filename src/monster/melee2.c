@@ -642,7 +642,7 @@ static bool get_moves_aux(struct cave *c, int m_idx, int *yp, int *xp)
 
 	int i, y, x, y1, x1;
 
-	int when = 0;
+	u32b when = 0;
 	int cost = 999;
 
 	monster_type *m_ptr = cave_monster(cave, m_idx);
@@ -661,10 +661,10 @@ static bool get_moves_aux(struct cave *c, int m_idx, int *yp, int *xp)
 	x1 = m_ptr->fx;
 
 	/* The player is not currently near the monster grid */
-	if (c->when[y1][x1] < c->when[py][px])
+	if (cave_flow_when(c, y1, x1) < cave_flow_when(c, py, px))
 	{
 		/* The player has never been near the monster grid */
-		if (c->when[y1][x1] == 0) return (FALSE);
+		if (cave_flow_when(c, y1, x1) == 0) return (FALSE);
 
 		/* The monster is not allowed to track the player */
 		if (!OPT(birth_ai_smell)) return (FALSE);
@@ -685,16 +685,16 @@ static bool get_moves_aux(struct cave *c, int m_idx, int *yp, int *xp)
 		x = x1 + ddx_ddd[i];
 
 		/* Ignore illegal locations */
-		if (c->when[y][x] == 0) continue;
+		if (cave_flow_when(c, y, x) == 0) continue;
 
 		/* Ignore ancient locations */
-		if (c->when[y][x] < when) continue;
+		if (cave_flow_when(c, y, x) < when) continue;
 
 		/* Ignore distant locations */
 		if (c->cost[y][x] > cost) continue;
 
 		/* Save the cost and time */
-		when = c->when[y][x];
+		when = cave_flow_when(c, y, x);
 		cost = c->cost[y][x];
 
 		/* Hack -- Save the "twiddled" location */
@@ -719,7 +719,8 @@ static bool get_moves_aux(struct cave *c, int m_idx, int *yp, int *xp)
 static bool get_fear_moves_aux(struct cave *c, int m_idx, int *yp, int *xp)
 {
 	int y, x, y1, x1, fy, fx, py, px, gy = 0, gx = 0;
-	int when = 0, score = -1;
+	u32b when = 0;
+	int score = -1;
 	int i;
 
 	monster_type *m_ptr = cave_monster(cave, m_idx);
@@ -738,7 +739,7 @@ static bool get_fear_moves_aux(struct cave *c, int m_idx, int *yp, int *xp)
 	x1 = fx - (*xp);
 
 	/* The player is not currently near the monster grid */
-	if (c->when[fy][fx] < c->when[py][px])
+	if (cave_flow_when(c, fy, fx) < cave_flow_when(c, py, px))
 	{
 		/* No reason to attempt flowing */
 		return (FALSE);
@@ -758,10 +759,10 @@ static bool get_fear_moves_aux(struct cave *c, int m_idx, int *yp, int *xp)
 		x = fx + ddx_ddd[i];
 
 		/* Ignore illegal locations */
-		if (c->when[y][x] == 0) continue;
+		if (cave_flow_when(c, y, x) == 0) continue;
 
 		/* Ignore ancient locations */
-		if (c->when[y][x] < when) continue;
+		if (cave_flow_when(c, y, x) < when) continue;
 
 		/* Calculate distance of this grid from our destination */
 		dis = distance(y, x, y1, x1);
@@ -776,7 +777,7 @@ static bool get_fear_moves_aux(struct cave *c, int m_idx, int *yp, int *xp)
 		if (s < score) continue;
 
 		/* Save the score and time */
-		when = c->when[y][x];
+		when = cave_flow_when(c, y, x);
 		score = s;
 
 		/* Save the location */
@@ -983,7 +984,7 @@ static bool find_safety(struct cave *c, int m_idx, int *yp, int *xp)
 			if (!cave_floor_bold(y, x)) continue;
 
 			/* Ignore grids very far from the player */
-			if (c->when[y][x] < c->when[py][px]) continue;
+			if (cave_flow_when(c, y, x) < cave_flow_when(c, py, px)) continue;
 
 			/* Ignore too-distant grids */
 			if (c->cost[y][x] > c->cost[fy][fx] + 2 * d) continue;
@@ -3400,8 +3401,8 @@ static void process_monster(struct cave *c, int m_idx)
 		/* Update the visuals */
 		p_ptr->update |= (PU_UPDATE_VIEW | PU_MONSTERS);
 
-		/* Fully update the flow XXX XXX XXX */
-		p_ptr->update |= (PU_FORGET_FLOW | PU_UPDATE_FLOW);
+		/* Update the flow */
+		p_ptr->update |= (PU_UPDATE_FLOW);
 	}
 
 
@@ -3429,7 +3430,7 @@ static bool monster_can_flow(struct cave *c, int m_idx)
 	fx = m_ptr->fx;
 
 	/* Check the flow (normal aaf is about 20) */
-	if ((c->when[fy][fx] == c->when[p_ptr->py][p_ptr->px]) &&
+	if ((cave_flow_when(c, fy, fx) == cave_flow_when(c, p_ptr->py, p_ptr->px)) &&
 	    (c->cost[fy][fx] < MONSTER_FLOW_DEPTH) &&
 	    (c->cost[fy][fx] < (OPT(birth_small_range) ? r_ptr->aaf / 2 : r_ptr->aaf)))
 		return TRUE;
@@ -3466,8 +3467,9 @@ void process_monsters(struct cave *c, byte minimum_energy)
 	monster_type *m_ptr;
 	monster_race *r_ptr;
 
-	/* Process the monsters (backwards) */
-	for (i = cave_monster_max(c) - 1; i >= 1; i--)
+	/* Process the monsters with enough energy to move (backwards) */
+	for (i = mon_sched_next(c, cave_monster_max(c), minimum_energy); i;
+			i = mon_sched_next(c, i, minimum_energy))
 	{
 		/* Handle "leaving" */
 		if (p_ptr->leaving) break;
@@ -3477,15 +3479,8 @@ void process_monsters(struct cave *c, byte minimum_energy)
 		m_ptr = cave_monster(cave, i);
 
 
-		/* Ignore "dead" monsters */
-		if (!m_ptr->r_idx) continue;
-
-
-		/* Not enough energy to move */
-		if (m_ptr->energy < minimum_energy) continue;
-
 		/* Use up "some" energy */
-		m_ptr->energy -= 100;
+		monster_set_energy(c, m_ptr, monster_energy(c, m_ptr) - 100);
 
 
 		/* Heal monster? XXX XXX XXX */
@@ -49,6 +49,7 @@ void delete_monster_idx(int m_idx)
 
 	/* Hack -- Reduce the racial counter */
 	r_ptr->cur_num--;
+	if (rf_has(r_ptr->flags, RF_UNIQUE)) get_mon_num_reset();
 
 	/* Hack -- count the number of "reproducers" */
 	if (rf_has(r_ptr->flags, RF_MULTIPLY)) num_repro--;
@@ -90,6 +91,9 @@ void delete_monster_idx(int m_idx)
 	if (m_ptr->mimicked_o_idx > 0)
 		delete_object_idx(m_ptr->mimicked_o_idx);
 
+	/* Stop scheduling it */
+	mon_sched_remove(cave, m_ptr);
+
 	/* Wipe the Monster */
 	(void)WIPE(m_ptr, monster_type);
 
@@ -135,6 +139,9 @@ static void compact_monsters_aux(int i1, int i2)
 
 	/* Update the cave */
 	cave->m_idx[y][x] = i2;
+
+	/* Schedule it under its new index */
+	mon_sched_remove(cave, m_ptr);
 	
 	/* Update midx */
 	m_ptr->midx = i2;
@@ -175,6 +182,7 @@ static void compact_monsters_aux(int i1, int i2)
 
 	/* Hack -- move monster */
 	COPY(cave_monster(cave, i2), cave_monster(cave, i1), struct monster);
+	mon_sched_update(cave, cave_monster(cave, i2));
 
 	/* Hack -- wipe hole */
 	(void)WIPE(cave_monster(cave, i1), monster_type);
@@ -291,6 +299,7 @@ void wipe_mon_list(struct cave *c, struct player *p)
 
 		/* Hack -- Reduce the racial counter */
 		r_ptr->cur_num--;
+		if (rf_has(r_ptr->flags, RF_UNIQUE)) get_mon_num_reset();
 
 		/* Monster is gone */
 		c->m_idx[m_ptr->fy][m_ptr->fx] = 0;
@@ -305,6 +314,9 @@ void wipe_mon_list(struct cave *c, struct player *p)
 	/* Reset "mon_cnt" */
 	cave->mon_cnt = 0;
 
+	/* Nothing to schedule */
+	mon_sched_wipe(c);
+
 	/* Hack -- reset "reproducer" count */
 	num_repro = 0;
 
@@ -367,6 +379,38 @@ static s16b mon_pop(void)
 }
 
 
+/**
+ * Alias tables for get_mon_num(), one for each level.  Each is built the
+ * first time that level is asked for, and again only once the set of
+ * monsters that may appear has changed (see get_mon_num_reset()).
+ */
+static struct alias_table mon_alloc[MAX_DEPTH];
+static u32b mon_alloc_stamp[MAX_DEPTH];
+static u32b mon_alloc_gen = 1;
+static int mon_alloc_depth;
+
+/**
+ * Note that the monsters get_mon_num() may choose have changed, because
+ * of a new restriction hook or a unique being born, killed or revived.
+ */
+void get_mon_num_reset(void)
+{
+	mon_alloc_gen++;
+}
+
+/**
+ * Free the get_mon_num() alias tables.
+ */
+void free_mon_alloc(void)
+{
+	int i;
+
+	for (i = 0; i < MAX_DEPTH; i++)
+		Rand_alias_free(&mon_alloc[i]);
+
+	get_mon_num_reset();
+}
+
 /**
  * Apply a "monster restriction function" to the "monster allocation table".
  * This way, we can use get_mon_num() to get a level-appropriate monster that
@@ -390,43 +434,55 @@ void get_mon_num_prep(void)
 			entry->prob2 = 0;
 	}
 
-	return;
+	get_mon_num_reset();
 }
 
 /**
- * Helper function for get_mon_num(). Scans the prepared monster allocation
- * table and picks a random monster. Returns the index of a monster in
- * `table`.
+ * Helper function for get_mon_num(). Builds the alias table for `level`
+ * from the prepared monster allocation table.
  */
-int get_mon_num_aux(long total, const alloc_entry *table)
+static void get_mon_num_build(int level)
 {
-	int i;
-	
-	long value;
-	
-	/* Pick a monster */
-	value = randint0(total);
+	struct alias_table *t = &mon_alloc[level];
+	alloc_entry *table = alloc_race_table;
+	int i, n;
 
-	/* Find the monster */
-	for (i = 0; i < alloc_race_size; i++)
-	{
-		/* Found the entry */
-		if (value < table[i].prob3) break;
+	/* Monsters are sorted by depth */
+	for (n = 0; n < alloc_race_size; n++)
+		if (table[n].level > level) break;
+
+	Rand_alias_init(t, n);
+
+	for (i = 0; i < n; i++) {
+		monster_race *r_ptr = &r_info[table[i].index];
+
+		/* Hack -- No town monsters in dungeon */
+		if ((level > 0) && (table[i].level <= 0)) continue;
 
-		/* Decrement */
-		value = value - table[i].prob3;
+		/* Hack -- "unique" monsters must be "unique" */
+		if (rf_has(r_ptr->flags, RF_UNIQUE) && 
+				r_ptr->cur_num >= r_ptr->max_num)
+			continue;
+
+		/* Depth Monsters never appear out of depth */
+		if (rf_has(r_ptr->flags, RF_FORCE_DEPTH) && 
+				r_ptr->level > p_ptr->depth)
+			continue;
+
+		/* Accept */
+		t->prob[i] = table[i].prob2;
 	}
-	
-	return i;
+
+	Rand_alias_build(t);
+	mon_alloc_stamp[level] = mon_alloc_gen;
 }
 
 /**
  * Chooses a monster race that seems "appropriate" to the given level
  *
  * This function uses the "prob2" field of the "monster allocation table",
- * and various local information, to calculate the "prob3" field of the
- * same table, which is then used to choose an "appropriate" monster, in
- * a relatively efficient manner.
+ * and various local information, to build an alias table for the level,
+ * which is then used to choose an "appropriate" monster in constant time.
  *
  * Note that "town" monsters will *only* be created in the town, and
  * "normal" monsters will *never* be created in the town, unless the
@@ -446,57 +502,30 @@ s16b get_mon_num(int level)
 {
 	int i, j, p;
 
-	int r_idx;
-
-	long total;
-
-	monster_race *r_ptr;
-
 	alloc_entry *table = alloc_race_table;
 
 	/* Occasionally produce a nastier monster in the dungeon */
 	if (level > 0 && one_in_(NASTY_MON))
 		level += MIN(level / 4 + 2, MON_OOD_MAX);
 
-	total = 0L;
-
-	/* Process probabilities */
-	for (i = 0; i < alloc_race_size; i++) {
-		/* Monsters are sorted by depth */
-		if (table[i].level > level) break;
-
-		/* Default */
-		table[i].prob3 = 0;
-
-		/* Hack -- No town monsters in dungeon */
-		if ((level > 0) && (table[i].level <= 0)) continue;
-
-		/* Get the chosen monster */
-		r_idx = table[i].index;
-		r_ptr = &r_info[r_idx];
-
-		/* Hack -- "unique" monsters must be "unique" */
-		if (rf_has(r_ptr->flags, RF_UNIQUE) && 
-				r_ptr->cur_num >= r_ptr->max_num)
-			continue;
-
-		/* Depth Monsters never appear out of depth */
-		if (rf_has(r_ptr->flags, RF_FORCE_DEPTH) && 
-				r_ptr->level > p_ptr->depth)
-			continue;
-
-		/* Accept */
-		table[i].prob3 = table[i].prob2;
+	/* No monster is this deep, so every deeper level is the same */
+	level = MIN(level, MAX_DEPTH - 1);
 
-		/* Total */
-		total += table[i].prob3;
+	/* Depth monsters depend on the player's depth */
+	if (p_ptr->depth != mon_alloc_depth) {
+		mon_alloc_depth = p_ptr->depth;
+		get_mon_num_reset();
 	}
 
-	/* No legal monsters */
-	if (total <= 0) return (0);
+	/* Process probabilities */
+	if (mon_alloc_stamp[level] != mon_alloc_gen)
+		get_mon_num_build(level);
 
 	/* Pick a monster */
-	i = get_mon_num_aux(total, table);
+	i = Rand_alias(&mon_alloc[level]);
+
+	/* No legal monsters */
+	if (i < 0) return (0);
 
 	/* Try for a "harder" monster once (50%) or twice (10%) */
 	p = randint0(100);
@@ -506,7 +535,7 @@ s16b get_mon_num(int level)
 		j = i;
 
 		/* Pick a monster */
-		i = get_mon_num_aux(total, table);
+		i = Rand_alias(&mon_alloc[level]);
 
 		/* Keep the deepest one */
 		if (table[i].level < table[j].level) i = j;
@@ -518,7 +547,7 @@ s16b get_mon_num(int level)
 		j = i;
 
 		/* Pick a monster */
-		i = get_mon_num_aux(total, table);
+		i = Rand_alias(&mon_alloc[level]);
 
 		/* Keep the deepest one */
 		if (table[i].level < table[j].level) i = j;
@@ -677,6 +706,9 @@ s16b place_monster(int y, int x, monster_type *n_ptr, byte origin)
 	m_ptr->fy = y;
 	m_ptr->fx = x;
 
+	/* Schedule it by its energy */
+	mon_sched_add(cave, m_ptr);
+
 	update_mon(m_idx, TRUE);
 
 	/* Get the new race */
@@ -687,6 +719,7 @@ s16b place_monster(int y, int x, monster_type *n_ptr, byte origin)
 
 	/* Count racial occurrences */
 	r_ptr->cur_num++;
+	if (rf_has(r_ptr->flags, RF_UNIQUE)) get_mon_num_reset();
 
 	/* Create the monster's drop, if any */
 	if (origin)
@@ -1261,8 +1294,8 @@ static void build_quest_stairs(int y, int x)
 	/* Update the visuals */
 	p_ptr->update |= (PU_UPDATE_VIEW | PU_MONSTERS);
 
-	/* Fully update the flow */
-	p_ptr->update |= (PU_FORGET_FLOW | PU_UPDATE_FLOW);
+	/* Update the flow */
+	p_ptr->update |= (PU_UPDATE_FLOW);
 }
 
 
@@ -1485,6 +1518,7 @@ bool mon_take_hit(struct monster *m_ptr, int dam, bool *fear, const char *note)
 		if (rf_has(r_ptr->flags, RF_UNIQUE)) {
 			char unique_name[80];
 			r_ptr->max_num = 0;
+			get_mon_num_reset();
 
 			/* 
 			 * This gets the correct name if we slay an invisible 
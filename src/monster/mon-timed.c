@@ -204,6 +204,10 @@ static bool mon_set_timed(monster_type *m_ptr, int ef_idx, int timer,
 	else
 		m_ptr->m_timed[ef_idx] = timer;
 
+	/* Haste and slowness change when it can next act */
+	if (!resisted && (ef_idx == MON_TMD_FAST || ef_idx == MON_TMD_SLOW))
+		mon_sched_update(cave, m_ptr);
+
 	if (p_ptr->health_who == m_ptr) p_ptr->redraw |= (PR_HEALTH);
 
 	/* Update the visuals, as appropriate. */
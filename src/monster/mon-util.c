@@ -793,6 +793,55 @@ void monster_desc(char *desc, size_t max, const monster_type *m_ptr, int mode)
 
 
 
+/*
+ * Work out the distance from the player to the monster.
+ *
+ * Note the optimized "inline" version of the "distance()" function.
+ */
+static void monster_update_distance(struct monster *m_ptr)
+{
+	int py = p_ptr->py;
+	int px = p_ptr->px;
+
+	/* Distance components */
+	int dy = (py > m_ptr->fy) ? (py - m_ptr->fy) : (m_ptr->fy - py);
+	int dx = (px > m_ptr->fx) ? (px - m_ptr->fx) : (m_ptr->fx - px);
+
+	/* Approximate distance */
+	int d = (dy > dx) ? (dy + (dx>>1)) : (dx + (dy>>1));
+
+	/* Restrict distance, and save it */
+	m_ptr->cdis = (d > 255) ? 255 : d;
+}
+
+/*
+ * Bits of a monster's "vis_key", above its distance
+ */
+#define VIS_KEY_VIEW	0x0100	/* Its grid is in line of sight */
+#define VIS_KEY_SEEN	0x0200	/* Its grid is in line of sight and lit */
+#define VIS_KEY_MARK	0x0400	/* It has been detected */
+#define VIS_KEY_WEIRD	0x0800	/* It shows to telepathy if weird minded */
+#define VIS_KEY_MIMIC	0x1000	/* It is (or was) mimicking an object */
+#define VIS_KEY_VALID	0x8000	/* Never set in a new monster */
+
+/*
+ * Sum up what update_mon() looks at for a monster, apart from the player's
+ * state.  All distances beyond MAX_SIGHT look the same.
+ */
+static u16b monster_vis_key(const struct monster *m_ptr)
+{
+	byte info = cave->info[m_ptr->fy][m_ptr->fx];
+	u16b key = VIS_KEY_VALID | MIN(m_ptr->cdis, MAX_SIGHT + 1);
+
+	if (info & CAVE_VIEW) key |= VIS_KEY_VIEW;
+	if (info & CAVE_SEEN) key |= VIS_KEY_SEEN;
+	if (m_ptr->mflag & MFLAG_MARK) key |= VIS_KEY_MARK;
+	if (m_ptr->midx % 10 == 5) key |= VIS_KEY_WEIRD;
+	if (m_ptr->mimicked_o_idx) key |= VIS_KEY_MIMIC;
+
+	return key;
+}
+
 /**
  * This function updates the monster record of the given monster
  *
@@ -831,9 +880,8 @@ void monster_desc(char *desc, size_t max, const monster_type *m_ptr, int mode)
  * Note that this function is called once per monster every time the
  * player moves.  When the player is running, this function is one
  * of the primary bottlenecks, along with "update_view()" and the
- * "process_monsters()" code, so efficiency is important.
- *
- * Note the optimized "inline" version of the "distance()" function.
+ * "process_monsters()" code, so efficiency is important.  See
+ * update_monsters() for how most of those calls are avoided.
  *
  * A monster is "visible" to the player if (1) it has been detected
  * by the player, (2) it is close to the player and the player has
@@ -878,29 +926,10 @@ void update_mon(int m_idx, bool full)
 	fx = m_ptr->fx;
 
 	/* Compute distance */
-	if (full) {
-		int py = p_ptr->py;
-		int px = p_ptr->px;
-
-		/* Distance components */
-		int dy = (py > fy) ? (py - fy) : (fy - py);
-		int dx = (px > fx) ? (px - fx) : (fx - px);
-
-		/* Approximate distance */
-		d = (dy > dx) ? (dy + (dx>>1)) : (dx + (dy>>1));
-
-		/* Restrict distance */
-		if (d > 255) d = 255;
-
-		/* Save the distance */
-		m_ptr->cdis = d;
-	}
+	if (full) monster_update_distance(m_ptr);
 
 	/* Extract distance */
-	else {
-		/* Extract the distance */
-		d = m_ptr->cdis;
-	}
+	d = m_ptr->cdis;
 
 	/* Detected */
 	if (m_ptr->mflag & (MFLAG_MARK)) flag = TRUE;
@@ -1076,18 +1105,59 @@ void update_mon(int m_idx, bool full)
 			p_ptr->redraw |= PR_MONLIST;
 		}
 	}
+
+	/* Remember what we saw */
+	m_ptr->vis_key = monster_vis_key(m_ptr);
 }
 
 
+/*
+ * The parts of the player's state that update_mon() looks at
+ */
+struct player_vis_key {
+	bool telepathy;
+	bool blind;
+	bool see_invis;
+	int see_infra;
+};
+
+static void player_vis_key(struct player_vis_key *key)
+{
+	WIPE(key, struct player_vis_key);
+	key->telepathy = check_state(p_ptr, OF_TELEPATHY, p_ptr->state.flags);
+	key->blind = p_ptr->timed[TMD_BLIND] ? TRUE : FALSE;
+	key->see_invis = check_state(p_ptr, OF_SEE_INVIS, p_ptr->state.flags);
+	key->see_infra = p_ptr->state.see_infra;
+}
 
+/*
+ * The work done by update_monsters(), shown by the debug command 'M'
+ */
+struct monster_update_count mon_update_count;
 
 /**
  * Updates all the (non-dead) monsters via update_mon().
+ *
+ * A monster only needs update_mon() if something it depends on has changed
+ * since the last time: the player's state, or the monster's own inputs as
+ * summed up in its "vis_key".  Most monsters on a level are far from the
+ * player and stay unseen however the player moves, so only their distance
+ * needs working out again.
  */
 void update_monsters(bool full)
 {
+	static struct player_vis_key last_key;
+	struct player_vis_key key;
+	bool all;
 	int i;
 
+	/* Everything may look different to a changed player */
+	player_vis_key(&key);
+	all = memcmp(&key, &last_key, sizeof(key)) != 0;
+	last_key = key;
+
+	mon_update_count.calls++;
+
 	/* Update each (live) monster */
 	for (i = 1; i < cave_monster_max(cave); i++) {
 		monster_type *m_ptr = cave_monster(cave, i);
@@ -1095,8 +1165,19 @@ void update_monsters(bool full)
 		/* Skip dead monsters */
 		if (!m_ptr->r_idx) continue;
 
+		/* Compute distance */
+		if (full) monster_update_distance(m_ptr);
+
+		/* Skip monsters which would look the same as last time */
+		if (!all && !(m_ptr->vis_key & VIS_KEY_MIMIC) &&
+				m_ptr->vis_key == monster_vis_key(m_ptr)) {
+			mon_update_count.skipped++;
+			continue;
+		}
+
 		/* Update the monster */
-		update_mon(i, full);
+		update_mon(i, FALSE);
+		mon_update_count.visited++;
 	}
 }
 
@@ -1415,7 +1496,7 @@ int summon_specific(int y1, int x1, int lev, int type, int delay)
 	/* If delay, try to let the player act before the summoned monsters,
 	 * including slowing down faster monsters for one turn */
 	if (delay) {
-		m_ptr->energy = 0;
+		monster_set_energy(cave, m_ptr, 0);
 		if (r_ptr->speed > p_ptr->state.speed)
 			mon_inc_timed(m_ptr, MON_TMD_SLOW, 1,
 				MON_TMD_FLG_NOMESSAGE, FALSE);
@@ -1565,3 +1646,195 @@ void update_smart_learn(struct monster *m, struct player *p, int flag)
 		of_off(m->known_pflags, flag);
 }
 
+
+
+/*
+ * Monster scheduling
+ *
+ * Rather than every monster being given its energy each game turn, a
+ * monster's energy is kept as of the turn it was last brought up to date
+ * and worked out from its speed when needed.  Monsters with 100 energy or
+ * more are in the cave's "ready" bitmap; each of the others is in the wheel
+ * bitmap for the game turn it reaches 100.  process_monsters() then only
+ * visits ready monsters, in the same order as a scan of the whole list.
+ */
+
+/*
+ * The bitmap for game turn `turn` of the schedule.
+ */
+static u32b *mon_wheel_slot(struct cave *c, s32b turn)
+{
+	return c->mon_wheel + (turn % MON_WHEEL) * c->mon_words;
+}
+
+/*
+ * Energy gained per game turn at the monster's current speed.
+ */
+static byte monster_energy_gain(const struct monster *m)
+{
+	int mspeed = m->mspeed;
+
+	if (m->m_timed[MON_TMD_FAST]) mspeed += 10;
+	if (m->m_timed[MON_TMD_SLOW]) mspeed -= 10;
+
+	return extract_energy[mspeed];
+}
+
+/*
+ * Bring the monster's energy up to date, at the speed it has been moving.
+ */
+static void monster_settle_energy(struct cave *c, struct monster *m)
+{
+	m->energy = monster_energy(c, m);
+	m->energy_turn = c->mon_turn;
+}
+
+/*
+ * Put a monster with up to date energy into the schedule.
+ */
+static void mon_sched_place(struct cave *c, struct monster *m)
+{
+	u32b bit = 1UL << (m->midx % 32);
+
+	m->energy_gain = monster_energy_gain(m);
+
+	if (m->energy >= 100) {
+		m->energy_due = c->mon_turn;
+		c->mon_ready[m->midx / 32] |= bit;
+	} else {
+		int wait = (100 - m->energy + m->energy_gain - 1) / m->energy_gain;
+
+		m->energy_due = c->mon_turn + wait;
+		mon_wheel_slot(c, m->energy_due)[m->midx / 32] |= bit;
+	}
+}
+
+/*
+ * Add a new monster, whose energy has just been set, to the schedule.
+ */
+void mon_sched_add(struct cave *c, struct monster *m)
+{
+	m->energy_turn = c->mon_turn;
+	mon_sched_place(c, m);
+}
+
+/*
+ * Take a monster out of the schedule.
+ */
+void mon_sched_remove(struct cave *c, struct monster *m)
+{
+	u32b bit = 1UL << (m->midx % 32);
+
+	c->mon_ready[m->midx / 32] &= ~bit;
+	mon_wheel_slot(c, m->energy_due)[m->midx / 32] &= ~bit;
+}
+
+/*
+ * Reschedule a monster whose speed has changed.
+ *
+ * Energy up to now is counted at the old speed, as the game turns it was
+ * earned in had already passed.
+ */
+void mon_sched_update(struct cave *c, struct monster *m)
+{
+	monster_settle_energy(c, m);
+	mon_sched_remove(c, m);
+	mon_sched_place(c, m);
+}
+
+/*
+ * Forget every monster, when the monster list is wiped.
+ */
+void mon_sched_wipe(struct cave *c)
+{
+	C_WIPE(c->mon_ready, c->mon_words, u32b);
+	C_WIPE(c->mon_wheel, MON_WHEEL * c->mon_words, u32b);
+}
+
+/*
+ * Give every monster its energy for one game turn.  Those now able to act
+ * become ready.
+ */
+void mon_sched_tick(struct cave *c)
+{
+	u32b *due;
+	int i;
+
+	c->mon_turn++;
+	due = mon_wheel_slot(c, c->mon_turn);
+
+	for (i = 0; i < c->mon_words; i++) {
+		c->mon_ready[i] |= due[i];
+		due[i] = 0;
+	}
+}
+
+/*
+ * Return the position of the highest bit set in `x`, which must not be 0.
+ * Branch free, as the bits of the ready bitmap are not predictable.
+ */
+static int highest_bit(u32b x)
+{
+	/* Set every bit below the highest, then count them */
+	x |= x >> 1;
+	x |= x >> 2;
+	x |= x >> 4;
+	x |= x >> 8;
+	x |= x >> 16;
+
+	x -= (x >> 1) & 0x55555555UL;
+	x = (x & 0x33333333UL) + ((x >> 2) & 0x33333333UL);
+	x = (x + (x >> 4)) & 0x0F0F0F0FUL;
+
+	return (int)(((x * 0x01010101UL) & 0xFFFFFFFFUL) >> 24) - 1;
+}
+
+/*
+ * Return the index of the next monster below `m_idx` with at least
+ * `min_energy` energy (which must be 100 or more), or 0 if there is none.
+ */
+int mon_sched_next(struct cave *c, int m_idx, byte min_energy)
+{
+	int i = m_idx - 1;
+
+	while (i >= 1) {
+		u32b ready = c->mon_ready[i / 32];
+		int bit = i % 32;
+
+		/* Skip words with no ready monsters below m_idx */
+		if (bit < 31) ready &= (2UL << bit) - 1;
+		if (!ready) {
+			i -= bit + 1;
+			continue;
+		}
+
+		i -= bit - highest_bit(ready);
+		if (i < 1) break;
+
+		if (monster_energy(c, cave_monster(c, i)) >= min_energy)
+			return i;
+
+		i--;
+	}
+
+	return 0;
+}
+
+/*
+ * Return the monster's energy now.
+ */
+byte monster_energy(struct cave *c, const struct monster *m)
+{
+	return (byte)(m->energy + m->energy_gain * (c->mon_turn - m->energy_turn));
+}
+
+/*
+ * Set the monster's energy, and reschedule it.
+ */
+void monster_set_energy(struct cave *c, struct monster *m, int energy)
+{
+	mon_sched_remove(c, m);
+	m->energy = (byte)energy;
+	m->energy_turn = c->mon_turn;
+	mon_sched_place(c, m);
+}
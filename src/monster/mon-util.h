@@ -41,8 +41,16 @@
 
 /** Structures **/
 
+/* Counts of the work done by update_monsters() */
+struct monster_update_count {
+	u32b calls;		/* Calls to update_monsters() */
+	u32b visited;	/* Monsters it passed to update_mon() */
+	u32b skipped;	/* Monsters it found would look the same */
+};
+
 /** Variables **/
 extern wchar_t summon_kin_type;		/* Hack -- See summon_specific() */
+extern struct monster_update_count mon_update_count;
 
 
 /** Functions **/
@@ -61,5 +69,13 @@ bool multiply_monster(int m_idx);
 void become_aware(struct monster *m);
 bool is_mimicking(struct monster *m);
 void update_smart_learn(struct monster *m, struct player *p, int flag);
+void mon_sched_add(struct cave *c, struct monster *m);
+void mon_sched_remove(struct cave *c, struct monster *m);
+void mon_sched_update(struct cave *c, struct monster *m);
+void mon_sched_wipe(struct cave *c);
+void mon_sched_tick(struct cave *c);
+int mon_sched_next(struct cave *c, int m_idx, byte min_energy);
+byte monster_energy(struct cave *c, const struct monster *m);
+void monster_set_energy(struct cave *c, struct monster *m, int energy);
 
 #endif /* MONSTER_UTILITIES_H */
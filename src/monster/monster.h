@@ -234,9 +234,13 @@ typedef struct monster
 	s16b m_timed[MON_TMD_MAX]; /* Timed monster status effects */
 
 	byte mspeed;		/* Monster "speed" */
-	byte energy;		/* Monster "energy" */
+	byte energy;		/* Monster "energy", as of "energy_turn" */
+	byte energy_gain;	/* Energy gained per game turn (see mon-util.c) */
+	s32b energy_turn;	/* Scheduler turn "energy" was brought up to date */
+	s32b energy_due;	/* Scheduler turn of reaching 100 energy */
 
 	byte cdis;			/* Current dis from player */
+	u16b vis_key;		/* What update_mon() last saw (see mon-util.c) */
 
 	byte mflag;			/* Extra monster flags */
 
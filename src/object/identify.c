@@ -337,6 +337,7 @@ void object_flavor_aware(object_type *o_ptr)
 
 	if (o_ptr->kind->aware) return;
 	o_ptr->kind->aware = TRUE;
+	object_flags_forget(NULL);
 
 	/* Fix squelch/autoinscribe */
 	if (kind_is_squelched_unaware(o_ptr->kind)) {
@@ -379,6 +380,7 @@ void object_flavor_tried(object_type *o_ptr)
 void object_know_all_flags(object_type *o_ptr)
 {
 	of_setall(o_ptr->known_flags);
+	object_flags_forget(o_ptr);
 }
 
 
@@ -488,6 +490,7 @@ void object_notice_ego(object_type *o_ptr)
 	}
 
 	of_union(o_ptr->known_flags, learned_flags);
+	object_flags_forget(o_ptr);
 
 	if (object_add_ident_flags(o_ptr, IDENT_NAME))
 	{
@@ -615,6 +618,7 @@ bool object_notice_flag(object_type *o_ptr, int flag)
 	if (!of_has(o_ptr->known_flags, flag))
 	{
 		of_on(o_ptr->known_flags, flag);
+		object_flags_forget(o_ptr);
 		/* XXX Eddie don't want infinite recursion if object_check_for_ident sets more flags,
 		 * but maybe this will interfere with savefile repair
 		 */
@@ -637,6 +641,7 @@ bool object_notice_flags(object_type *o_ptr, bitflag flags[OF_SIZE])
 	if (!of_is_subset(o_ptr->known_flags, flags))
 	{
 		of_union(o_ptr->known_flags, flags);
+		object_flags_forget(o_ptr);
 		/* XXX Eddie don't want infinite recursion if object_check_for_ident sets more flags,
 		 * but maybe this will interfere with savefile repair
 		 */
@@ -770,6 +775,7 @@ void object_notice_on_wield(object_type *o_ptr)
 
 	/* Learn about obvious flags */
 	of_union(o_ptr->known_flags, obvious_mask);
+	object_flags_forget(o_ptr);
 
 	/* XXX Eddie should these next NOT call object_check_for_ident due to worries about repairing? */
 
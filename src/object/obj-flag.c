@@ -40,6 +40,29 @@ static const char *flag_names[] =
     ""
 };
 
+/**
+ * The flags of each type, and of each ID level, built from the table the
+ * first time they are needed.
+ */
+static bitflag type_masks[OFT_MAX][OF_SIZE];
+static bitflag id_masks[OFID_MAX][OF_SIZE];
+static bool masks_built = FALSE;
+
+static void build_masks(void)
+{
+	const struct object_flag *of_ptr;
+
+	/* Skip OF_NONE */
+	for (of_ptr = object_flag_table + 1; of_ptr->index < OF_MAX; of_ptr++) {
+		assert(of_ptr->type < OFT_MAX);
+		assert(of_ptr->id < OFID_MAX);
+		of_on(type_masks[of_ptr->type], of_ptr->index);
+		of_on(id_masks[of_ptr->id], of_ptr->index);
+	}
+
+	masks_built = TRUE;
+}
+
 /**
  * Create a "mask" of flags of a specific type or ID threshold.
  *
@@ -51,19 +74,19 @@ static const char *flag_names[] =
  */
 void create_mask(bitflag *f, bool id, ...)
 {
-	const struct object_flag *of_ptr;
 	int i;
 	va_list args;
 
+	if (!masks_built) build_masks();
+
 	of_wipe(f);
 
 	va_start(args, id);
 
 	/* Process each type in the va_args */
-    for (i = va_arg(args, int); i != OFT_MAX; i = va_arg(args, int)) {
-		for (of_ptr = object_flag_table; of_ptr->index < OF_MAX; of_ptr++)
-			if ((id && of_ptr->id == i) || (!id && of_ptr->type == i))
-				of_on(f, of_ptr->index);
+	for (i = va_arg(args, int); i != OFT_MAX; i = va_arg(args, int)) {
+		assert(i < (id ? OFID_MAX : OFT_MAX));
+		of_union(f, id ? id_masks[i] : type_masks[i]);
 	}
 
 	va_end(args);
@@ -65,7 +65,9 @@ enum object_flag_id {
 	OFID_NONE = 0,		/* never shown */
 	OFID_NORMAL,		/* normal ID on use */
 	OFID_TIMED,			/* obvious after time */
-	OFID_WIELD			/* obvious on wield */
+	OFID_WIELD,			/* obvious on wield */
+
+	OFID_MAX
 };
 
 #define OF_SIZE                	FLAG_SIZE(OF_MAX)
@@ -165,6 +165,7 @@ void ego_apply_magic(object_type *o_ptr, int level)
 
 	/* Apply remaining flags */
 	of_union(o_ptr->flags, f2);
+	object_flags_forget(o_ptr);
 
 	return;
 }
@@ -262,6 +263,7 @@ void copy_artifact_data(object_type *o_ptr, const artifact_type *a_ptr)
 	o_ptr->to_d = a_ptr->to_d;
 	o_ptr->weight = a_ptr->weight;
 	of_union(o_ptr->flags, a_ptr->flags);
+	object_flags_forget(o_ptr);
 }
 
 
@@ -730,15 +732,16 @@ static bool kind_is_good(const object_kind *kind)
 
 
 /** Arrays holding an index of objects to generate for a given level */
-static u32b obj_total[MAX_DEPTH];
 static byte *obj_alloc;
-
-static u32b obj_total_great[MAX_DEPTH];
 static byte *obj_alloc_great;
 
 /* Don't worry about probabilities for anything past dlev100 */
 #define MAX_O_DEPTH		100
 
+/** Alias tables over obj_alloc and obj_alloc_great, built when first used */
+static struct alias_table obj_alias[MAX_O_DEPTH + 1];
+static struct alias_table obj_alias_great[MAX_O_DEPTH + 1];
+
 /*
  * Using k_info[], init rarity data for the entire dungeon.
  */
@@ -749,16 +752,12 @@ bool init_obj_alloc(void)
 
 
 	/* Free obj_allocs if allocated */
-	FREE(obj_alloc);
+	free_obj_alloc();
 
 	/* Allocate and wipe */
 	obj_alloc = C_ZNEW((MAX_O_DEPTH + 1) * k_max, byte);
 	obj_alloc_great = C_ZNEW((MAX_O_DEPTH + 1) * k_max, byte);
 
-	/* Wipe the totals */
-	C_WIPE(obj_total, MAX_O_DEPTH + 1, u32b);
-	C_WIPE(obj_total_great, MAX_O_DEPTH + 1, u32b);
-
 
 	/* Init allocation data */
 	for (item = 1; item < k_max; item++)
@@ -778,12 +777,10 @@ bool init_obj_alloc(void)
 
 			/* Save the probability in the standard table */
 			if ((lev < min) || (lev > max)) rarity = 0;
-			obj_total[lev] += rarity;
 			obj_alloc[(lev * k_max) + item] = rarity;
 
 			/* Save the probability in the "great" table if relevant */
 			if (!kind_is_good(kind)) rarity = 0;
-			obj_total_great[lev] += rarity;
 			obj_alloc_great[(lev * k_max) + item] = rarity;
 		}
 	}
@@ -797,8 +794,31 @@ bool init_obj_alloc(void)
  */
 void free_obj_alloc(void)
 {
+	int lev;
+
 	FREE(obj_alloc);
 	FREE(obj_alloc_great);
+
+	for (lev = 0; lev <= MAX_O_DEPTH; lev++) {
+		Rand_alias_free(&obj_alias[lev]);
+		Rand_alias_free(&obj_alias_great[lev]);
+	}
+}
+
+
+/*
+ * Build the alias table for one level of obj_alloc or obj_alloc_great.
+ */
+static void build_obj_alias(struct alias_table *t, const byte *alloc)
+{
+	int item;
+
+	Rand_alias_init(t, z_info->k_max);
+
+	for (item = 1; item < z_info->k_max; item++)
+		t->prob[item] = alloc[item];
+
+	Rand_alias_build(t);
 }
 
 
@@ -807,9 +827,7 @@ void free_obj_alloc(void)
  */
 object_kind *get_obj_num(int level, bool good)
 {
-	/* This is the base index into obj_alloc for this dlev */
-	size_t ind, item;
-	u32b value;
+	struct alias_table *t;
 
 	/* Occasional level boost */
 	if ((level > 0) && one_in_(GREAT_OBJ))
@@ -823,36 +841,20 @@ object_kind *get_obj_num(int level, bool good)
 	level = MAX(level, 0);
 
 	/* Pick an object */
-	ind = level * z_info->k_max;
-
 	if (!good)
 	{
-		value = randint0(obj_total[level]);
-		for (item = 1; item < z_info->k_max; item++)
-		{
-			/* Found it */
-			if (value < obj_alloc[ind + item]) break;
-
-			/* Decrement */
-			value -= obj_alloc[ind + item];
-		}
+		t = &obj_alias[level];
+		if (!t->size) build_obj_alias(t, &obj_alloc[level * z_info->k_max]);
 	}
 	else
 	{
-		value = randint0(obj_total_great[level]);
-		for (item = 1; item < z_info->k_max; item++)
-		{
-			/* Found it */
-			if (value < obj_alloc_great[ind + item]) break;
-
-			/* Decrement */
-			value -= obj_alloc_great[ind + item];
-		}
+		t = &obj_alias_great[level];
+		if (!t->size)
+			build_obj_alias(t, &obj_alloc_great[level * z_info->k_max]);
 	}
 
-
 	/* Return the item index */
-	return objkind_byid(item);
+	return objkind_byid(Rand_alias(t));
 }
 
 
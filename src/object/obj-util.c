@@ -202,6 +202,7 @@ void flavor_init(void)
 		/* No flavor yields aware */
 		if (!k_ptr->flavor) k_ptr->aware = TRUE;
 	}
+	object_flags_forget(NULL);
 }
 
 
@@ -305,11 +306,40 @@ void object_flags(const object_type *o_ptr, bitflag flags[OF_SIZE])
 }
 
 
+/*
+ * The answer of object_flags_known() is kept on the object, and is good while
+ * its "known_when" matches "known_now".  Zero never matches, so a wiped object
+ * starts with nothing cached.
+ */
+static u32b known_now = 1;
+
+/*
+ * Forget the cached known flags of an object, after a change to its flags or
+ * what the player knows of them.  With no object, forget those of every
+ * object, after a change to the player's awareness of a flavour.
+ */
+void object_flags_forget(object_type *o_ptr)
+{
+	if (o_ptr)
+		o_ptr->known_when = 0;
+	else
+		known_now++;
+}
+
 /*
  * Obtain the flags for an item which are known to the player
  */
 void object_flags_known(const object_type *o_ptr, bitflag flags[OF_SIZE])
 {
+	/* Hack -- the cache is not part of the object's value */
+	object_type *cache = (object_type *)o_ptr;
+
+	if (o_ptr->known_when == known_now)
+	{
+		of_copy(flags, o_ptr->known_cache);
+		return;
+	}
+
 	object_flags(o_ptr, flags);
 
 	of_inter(flags, o_ptr->known_flags);
@@ -319,6 +349,9 @@ void object_flags_known(const object_type *o_ptr, bitflag flags[OF_SIZE])
 
 	if (o_ptr->ego && easy_know(o_ptr))
 		of_union(flags, o_ptr->ego->flags);
+
+	of_copy(cache->known_cache, flags);
+	cache->known_when = known_now;
 }
 
 /*
@@ -1733,6 +1766,7 @@ void object_absorb(object_type *o_ptr, const object_type *j_ptr)
 	/* Blend all knowledge */
 	o_ptr->ident |= (j_ptr->ident & ~IDENT_EMPTY);
 	of_union(o_ptr->known_flags, j_ptr->known_flags);
+	object_flags_forget(o_ptr);
 
 	/* Merge inscriptions */
 	if (j_ptr->note)
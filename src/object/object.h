@@ -496,6 +496,8 @@ typedef struct object
 	bitflag flags[OF_SIZE];		/**< Flags */
 	bitflag known_flags[OF_SIZE];	/**< Player-known flags */
 	bitflag pval_flags[MAX_PVALS][OF_SIZE];	/**< pval flags */
+	bitflag known_cache[OF_SIZE];	/**< object_flags_known(), if current */
+	u32b known_when;	/**< When known_cache was made (see obj-util.c) */
 	u16b ident;			/* Special flags */
 
 	s16b ac;			/* Normal AC */
@@ -635,6 +637,7 @@ void flavor_init(void);
 void reset_visuals(bool load_prefs);
 void object_flags(const object_type *o_ptr, bitflag flags[OF_SIZE]);
 void object_flags_known(const object_type *o_ptr, bitflag flags[OF_SIZE]);
+void object_flags_forget(object_type *o_ptr);
 char index_to_label(int i);
 s16b label_to_inven(int c);
 s16b label_to_equip(int c);
@@ -195,6 +195,8 @@ bool object_add_pval(object_type *o_ptr, int pval, int flag)
 	/* Sanity check (we may be called with 0 - see ticket #1451) */
 	if (!pval) return FALSE;
 
+	object_flags_forget(o_ptr);
+
 	create_mask(f, FALSE, OFT_PVAL, OFT_STAT, OFT_MAX);
 
 	if (of_has(o_ptr->flags, flag)) {
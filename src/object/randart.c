@@ -288,8 +288,12 @@ static byte *base_item_prob;
  */
 static byte *base_art_alloc;
 
-/* Global just for convenience. */
-static int verbose = 1;
+/*
+ * Global just for convenience.  Set to write every step of the generation,
+ * including each power evaluation, to randart.log; that log runs to a
+ * hundred megabytes and takes most of the time, so it's off by default.
+ */
+static int verbose = 0;
 
 char *artifact_gen_name(struct artifact *a, const char ***words) {
 	char buf[BUFLEN];
@@ -363,13 +367,65 @@ static s32b artifact_power(int a_idx)
 	if (!make_fake_artifact(&obj, &a_info[a_idx]))
 		return 0;
 
-	object_desc(buf, 256*sizeof(char), &obj, ODESC_PREFIX | ODESC_FULL | ODESC_SPOIL);
-	file_putf(log_file, "%s\n", buf);
+	/* The description is only for the log */
+	if (verbose)
+	{
+		object_desc(buf, 256*sizeof(char), &obj, ODESC_PREFIX | ODESC_FULL | ODESC_SPOIL);
+		file_putf(log_file, "%s\n", buf);
+	}
 
 	return object_power(&obj, verbose, log_file, TRUE);
 }
 
 
+/*
+ * Add the number of artifacts of each type to the running totals.
+ *
+ * The totals are never reset, so every call counts towards the frequencies
+ * of every later set of randarts this session.
+ * ToDo: replace this with full combination tracking
+ */
+static void count_artifact_types(void)
+{
+	int i;
+
+	for (i = 0; i < z_info->a_max; i++)
+	{
+		switch (a_info[i].tval)
+		{
+		case TV_SWORD:
+		case TV_POLEARM:
+		case TV_HAFTED:
+			art_melee_total++; break;
+		case TV_BOW:
+			art_bow_total++; break;
+		case TV_SOFT_ARMOR:
+		case TV_HARD_ARMOR:
+		case TV_DRAG_ARMOR:
+			art_armor_total++; break;
+		case TV_SHIELD:
+			art_shield_total++; break;
+		case TV_CLOAK:
+			art_cloak_total++; break;
+		case TV_HELM:
+		case TV_CROWN:
+			art_headgear_total++; break;
+		case TV_GLOVES:
+			art_glove_total++; break;
+		case TV_BOOTS:
+			art_boot_total++; break;
+		case TV_NULL:
+			break;
+		default:
+			art_other_total++;
+		}
+	}
+	art_total = art_melee_total + art_bow_total + art_armor_total +
+	            art_shield_total + art_cloak_total + art_headgear_total +
+	            art_glove_total + art_boot_total + art_other_total;
+}
+
+
 /*
  * Store the original artifact power ratings as a baseline
  */
@@ -415,41 +471,7 @@ static void store_base_power (void)
 	file_putf(log_file, "Mean is %d, variance is %d\n", avg_power, var_power);
 
 	/* Store the number of different types, for use later */
-	/* ToDo: replace this with full combination tracking */
-	for (i = 0; i < z_info->a_max; i++)
-	{
-		switch (a_info[i].tval)
-		{
-		case TV_SWORD:
-		case TV_POLEARM:
-		case TV_HAFTED:
-			art_melee_total++; break;
-		case TV_BOW:
-			art_bow_total++; break;
-		case TV_SOFT_ARMOR:
-		case TV_HARD_ARMOR:
-		case TV_DRAG_ARMOR:
-			art_armor_total++; break;
-		case TV_SHIELD:
-			art_shield_total++; break;
-		case TV_CLOAK:
-			art_cloak_total++; break;
-		case TV_HELM:
-		case TV_CROWN:
-			art_headgear_total++; break;
-		case TV_GLOVES:
-			art_glove_total++; break;
-		case TV_BOOTS:
-			art_boot_total++; break;
-		case TV_NULL:
-			break;
-		default:
-			art_other_total++;
-		}
-	}
-	art_total = art_melee_total + art_bow_total + art_armor_total +
-	            art_shield_total + art_cloak_total + art_headgear_total +
-	            art_glove_total + art_boot_total + art_other_total;
+	count_artifact_types();
 }
 
 
@@ -3181,8 +3203,15 @@ errr do_randart(u32b randart_seed, bool full)
 	{
 		/* Just for fun, look at the frequencies on the finished items */
 		/* Remove this prior to release */
-		store_base_power();
-		parse_frequencies();
+		if (verbose)
+		{
+			store_base_power();
+			parse_frequencies();
+		}
+
+		/* Only the type totals outlast this, so just count those */
+		else
+			count_artifact_types();
 
 		/* Close the log file */
 		if (verbose)
@@ -36,6 +36,14 @@ const struct slay slay_table[] =
  */
 static struct flag_cache *slay_cache;
 
+/**
+ * Room in the slay cache for combinations not found on ego items, the number
+ * of combinations that are, and the next extra entry to reuse when full
+ */
+#define SLAY_CACHE_EXTRA	256
+static int slay_cache_ego;
+static int slay_cache_next;
+
 
 /**
  * Remove slays which are duplicates, i.e. they have exactly the same "monster
@@ -264,6 +272,10 @@ s32b check_slay_cache(bitflag *index)
 /**
  * Fill in a value in the slay cache. Return TRUE if a change is made.
  *
+ * Combinations that aren't found on any ego item (random artifacts have
+ * plenty) are added after the ego ones, reusing the oldest once there are
+ * SLAY_CACHE_EXTRA of them.
+ *
  * \param index is the set of slay flags whose value we are adding
  * \param value is the value of the slay flags in index
  */
@@ -278,7 +290,14 @@ bool fill_slay_cache(bitflag *index, s32b value)
 		}
 	}
 
-	return FALSE;
+	if (i == slay_cache_ego + SLAY_CACHE_EXTRA) {
+		i = slay_cache_ego + slay_cache_next;
+		slay_cache_next = (slay_cache_next + 1) % SLAY_CACHE_EXTRA;
+	}
+
+	of_copy(slay_cache[i].flags, index);
+	slay_cache[i].value = value;
+	return TRUE;
 }
 
 /**
@@ -325,8 +344,11 @@ errr create_slay_cache(struct ego_item *items)
         }
     }
 
-    /* Allocate slay_cache with an extra empty element for an iteration stop */
-    slay_cache = C_ZNEW((count + 1), struct flag_cache);
+    /* Allocate slay_cache with room for other combinations, and an extra
+     * empty element for an iteration stop */
+    slay_cache = C_ZNEW((count + SLAY_CACHE_EXTRA + 1), struct flag_cache);
+    slay_cache_ego = count;
+    slay_cache_next = 0;
     count = 0;
 
     /* Populate the slay_cache */
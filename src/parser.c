@@ -107,8 +107,19 @@ struct parser {
 	struct parser_value *fhead;
 	struct parser_value *ftail;
 	void *priv;
+
+	/* Directives seen so far, while compiling a file */
+	byte *raw;
+	size_t raw_len;
+	size_t raw_size;
+	u32b raw_count;
+
+	/* Whether the last file came from its compiled copy */
+	bool cached;
 };
 
+static void raw_record(struct parser *p, struct parser_hook *h);
+
 struct parser *parser_new(void) {
 	struct parser *p = mem_zalloc(sizeof *p);
 	return p;
@@ -372,6 +383,9 @@ enum parser_error parser_parse(struct parser *p, const char *line) {
 
 	mem_free(cline);
 
+	if (p->raw)
+		raw_record(p, h);
+
 	p->error = h->func(p);
 	return p->error;
 }
@@ -421,6 +435,7 @@ static void clean_specs(struct parser_hook *h) {
 void parser_destroy(struct parser *p) {
 	struct parser_hook *h;
 	parser_freeold(p);
+	mem_free(p->raw);
 	while (p->hooks)
 	{
 		h = p->hooks->next;
@@ -629,26 +644,401 @@ errr run_parser(struct file_parser *fp) {
 	return r;
 }
 
+/*
+ * Compiled edit files
+ *
+ * Once an edit file has parsed cleanly, the values given to each directive
+ * are written to user/data/<name>.raw, along with a hash of the text and of
+ * the directives the parser knows.  While both hashes still match, later runs
+ * hand the stored values straight to the hooks and skip reading, tokenizing
+ * and converting the text.  The hooks themselves still build the tables, so
+ * the file holds no pointers and needs no fixing up.
+ *
+ * The file is a header of five little-endian u32bs (magic, version, hash,
+ * number of records, size of the records) followed by one record per line
+ * that reached a hook: the hook's place in the hook list (u16b), the line
+ * number (u32b), the number of values (byte) and then each value.  Strings
+ * and symbols are a u16b length and their bytes; everything else is u32bs.
+ */
+#define RAW_MAGIC	0x77617241	/* "Araw" */
+#define RAW_VERSION	1
+#define RAW_HEADER	20
+#define RAW_MAX		0x1000000
+
+/* Values are checked against the end of the records as they are read */
+struct raw_reader {
+	const byte *pos;
+	const byte *end;
+};
+
+/*
+ * FNV-1a hash of n bytes, continuing from hash
+ */
+static u32b raw_hash(u32b hash, const void *data, size_t n)
+{
+	const byte *b = data;
+
+	while (n--) {
+		hash ^= *b++;
+		hash *= 16777619;
+	}
+
+	return hash;
+}
+
+/*
+ * Hash the text of an open edit file, then the parser's directives, so that
+ * either changing gives a different hash.  Leaves the file at its start.
+ */
+static u32b raw_file_hash(struct parser *p, ang_file *fh)
+{
+	char buf[4096];
+	u32b hash = 2166136261UL;
+	struct parser_hook *h;
+	struct parser_spec *s;
+	int n;
+
+	while ((n = file_read(fh, buf, sizeof(buf))) > 0)
+		hash = raw_hash(hash, buf, n);
+	file_seek(fh, 0);
+
+	for (h = p->hooks; h; h = h->next) {
+		hash = raw_hash(hash, h->dir, strlen(h->dir) + 1);
+		for (s = h->fhead; s; s = s->next) {
+			byte type = s->type;
+
+			hash = raw_hash(hash, &type, 1);
+			hash = raw_hash(hash, s->name, strlen(s->name) + 1);
+		}
+	}
+
+	return hash;
+}
+
+static void raw_put(struct parser *p, const void *data, size_t n)
+{
+	if (p->raw_len + n > p->raw_size) {
+		while (p->raw_len + n > p->raw_size)
+			p->raw_size *= 2;
+		p->raw = mem_realloc(p->raw, p->raw_size);
+	}
+
+	memcpy(p->raw + p->raw_len, data, n);
+	p->raw_len += n;
+}
+
+static void raw_put16(struct parser *p, u16b v)
+{
+	byte b[2];
+
+	b[0] = v & 0xFF;
+	b[1] = (v >> 8) & 0xFF;
+	raw_put(p, b, 2);
+}
+
+static void raw_pack32(byte *b, u32b v)
+{
+	b[0] = v & 0xFF;
+	b[1] = (v >> 8) & 0xFF;
+	b[2] = (v >> 16) & 0xFF;
+	b[3] = (v >> 24) & 0xFF;
+}
+
+static void raw_put32(struct parser *p, u32b v)
+{
+	byte b[4];
+
+	raw_pack32(b, v);
+	raw_put(p, b, 4);
+}
+
+/*
+ * Note the values of the line just tokenized for hook h
+ */
+static void raw_record(struct parser *p, struct parser_hook *h)
+{
+	struct parser_hook *k;
+	struct parser_value *v;
+	u16b hook = 0;
+	byte n = 0;
+
+	for (k = p->hooks; k != h; k = k->next)
+		hook++;
+	for (v = p->fhead; v; v = (struct parser_value *)v->spec.next)
+		n++;
+
+	raw_put16(p, hook);
+	raw_put32(p, p->lineno);
+	raw_put(p, &n, 1);
+
+	for (v = p->fhead; v; v = (struct parser_value *)v->spec.next) {
+		int t = v->spec.type & ~PARSE_T_OPT;
+
+		if (t == PARSE_T_SYM || t == PARSE_T_STR) {
+			u16b len = strlen(v->u.sval);
+
+			raw_put16(p, len);
+			raw_put(p, v->u.sval, len);
+		} else if (t == PARSE_T_RAND) {
+			raw_put32(p, v->u.rval.base);
+			raw_put32(p, v->u.rval.dice);
+			raw_put32(p, v->u.rval.sides);
+			raw_put32(p, v->u.rval.m_bonus);
+		} else if (t == PARSE_T_INT) {
+			raw_put32(p, v->u.ival);
+		} else if (t == PARSE_T_UINT) {
+			raw_put32(p, v->u.uval);
+		} else {
+			raw_put32(p, v->u.cval);
+		}
+	}
+
+	p->raw_count++;
+}
+
+static bool raw_get16(struct raw_reader *r, u16b *v)
+{
+	if (r->end - r->pos < 2) return FALSE;
+
+	*v = r->pos[0] | (r->pos[1] << 8);
+	r->pos += 2;
+	return TRUE;
+}
+
+static bool raw_get32(struct raw_reader *r, u32b *v)
+{
+	if (r->end - r->pos < 4) return FALSE;
+
+	*v = (u32b)r->pos[0] | ((u32b)r->pos[1] << 8) |
+		((u32b)r->pos[2] << 16) | ((u32b)r->pos[3] << 24);
+	r->pos += 4;
+	return TRUE;
+}
+
+/*
+ * Read one record.  With run unset this only checks that the record is
+ * whole and fits the parser's hooks; with run set it rebuilds the line's
+ * values and calls the hook, leaving the result in p->error.
+ */
+static bool raw_replay(struct parser *p, struct raw_reader *r, bool run)
+{
+	struct parser_hook *h;
+	struct parser_spec *s;
+	u16b hook, len = 0;
+	u32b lineno, word[4];
+	byte n, i;
+	int j;
+
+	if (!raw_get16(r, &hook) || !raw_get32(r, &lineno)) return FALSE;
+	if (r->pos == r->end) return FALSE;
+	n = *r->pos++;
+
+	for (h = p->hooks; h && hook; h = h->next)
+		hook--;
+	if (!h) return FALSE;
+
+	if (run) {
+		parser_freeold(p);
+		p->lineno = lineno;
+		p->colno = 1;
+	}
+
+	for (s = h->fhead, i = 0; i < n; s = s->next, i++) {
+		int t;
+		struct parser_value *v;
+
+		if (!s) return FALSE;
+		t = s->type & ~PARSE_T_OPT;
+
+		if (t == PARSE_T_SYM || t == PARSE_T_STR) {
+			if (!raw_get16(r, &len) || r->end - r->pos < len) return FALSE;
+		} else {
+			for (j = 0; j < (t == PARSE_T_RAND ? 4 : 1); j++)
+				if (!raw_get32(r, &word[j])) return FALSE;
+		}
+
+		if (!run) {
+			if (t == PARSE_T_SYM || t == PARSE_T_STR)
+				r->pos += len;
+			continue;
+		}
+
+		p->colno++;
+		v = mem_alloc(sizeof *v);
+		v->spec.next = NULL;
+		v->spec.type = s->type;
+		v->spec.name = s->name;
+		if (t == PARSE_T_SYM || t == PARSE_T_STR) {
+			v->u.sval = mem_alloc(len + 1);
+			memcpy(v->u.sval, r->pos, len);
+			v->u.sval[len] = '\0';
+			r->pos += len;
+		} else if (t == PARSE_T_RAND) {
+			v->u.rval.base = (s32b)word[0];
+			v->u.rval.dice = (s32b)word[1];
+			v->u.rval.sides = (s32b)word[2];
+			v->u.rval.m_bonus = (s32b)word[3];
+		} else if (t == PARSE_T_INT) {
+			v->u.ival = (s32b)word[0];
+		} else if (t == PARSE_T_UINT) {
+			v->u.uval = word[0];
+		} else {
+			v->u.cval = (wchar_t)word[0];
+		}
+
+		if (!p->fhead)
+			p->fhead = v;
+		else
+			p->ftail->spec.next = &v->spec;
+		p->ftail = v;
+	}
+
+	/* A line may only stop short at an optional value */
+	if (s && !(s->type & PARSE_T_OPT)) return FALSE;
+
+	if (run)
+		p->error = h->func(p);
+	return TRUE;
+}
+
+/*
+ * Run the parser over the compiled copy of an edit file, if there is one
+ * made from the same text and directives.  Returns FALSE, having called no
+ * hooks, if the text parser is needed instead; otherwise leaves any hook's
+ * error in *r.
+ */
+static bool raw_parse(struct parser *p, const char *path, u32b hash, errr *r)
+{
+	byte header[RAW_HEADER];
+	u32b field[5], i;
+	struct raw_reader reader;
+	byte *data = NULL;
+	ang_file *fh;
+	bool valid = FALSE;
+
+	fh = file_open(path, MODE_READ, -1);
+	if (!fh) return FALSE;
+
+	reader.pos = header;
+	reader.end = header + RAW_HEADER;
+	if (file_read(fh, (char *)header, RAW_HEADER) == RAW_HEADER) {
+		for (i = 0; i < 5; i++)
+			raw_get32(&reader, &field[i]);
+
+		if (field[0] == RAW_MAGIC && field[1] == RAW_VERSION &&
+				field[2] == hash && field[4] <= RAW_MAX) {
+			data = mem_alloc(field[4] + 1);
+			valid = file_read(fh, (char *)data, field[4] + 1) == (int)field[4];
+		}
+	}
+	file_close(fh);
+
+	/* Check every record before running any of them */
+	reader.pos = data;
+	reader.end = data + (valid ? field[4] : 0);
+	for (i = 0; valid && i < field[3]; i++)
+		valid = raw_replay(p, &reader, FALSE);
+	if (reader.pos != reader.end)
+		valid = FALSE;
+
+	if (valid) {
+		reader.pos = data;
+		*r = 0;
+		for (i = 0; i < field[3] && !*r; i++) {
+			raw_replay(p, &reader, TRUE);
+			*r = p->error;
+		}
+	}
+
+	mem_free(data);
+	return valid;
+}
+
+/*
+ * Save the records made while parsing an edit file
+ */
+static void raw_save(struct parser *p, const char *path, u32b hash)
+{
+	char dir[1024];
+	byte header[RAW_HEADER];
+	ang_file *fh;
+	bool ok;
+
+	path_build(dir, sizeof(dir), ANGBAND_DIR_USER, "data");
+	if (!dir_create(dir)) return;
+
+	fh = file_open(path, MODE_WRITE, FTYPE_RAW);
+	if (!fh) return;
+
+	raw_pack32(header, RAW_MAGIC);
+	raw_pack32(header + 4, RAW_VERSION);
+	raw_pack32(header + 8, hash);
+	raw_pack32(header + 12, p->raw_count);
+	raw_pack32(header + 16, p->raw_len);
+
+	ok = file_write(fh, (char *)header, RAW_HEADER) &&
+		file_write(fh, (char *)p->raw, p->raw_len);
+	file_close(fh);
+
+	/* Never leave half a file to be checked next time */
+	if (!ok)
+		file_delete(path);
+}
+
 /* The basic file parsing function */
 errr parse_file(struct parser *p, const char *filename) {
 	char path[1024];
+	char raw[1024] = "";
 	char buf[1024];
 	ang_file *fh;
 	errr r = 0;
+	u32b hash = 0;
 
 	path_build(path, sizeof(path), ANGBAND_DIR_EDIT, format("%s.txt", filename));
 	fh = file_open(path, MODE_READ, -1);
 	if (!fh)
 		quit(format("Cannot open '%s.txt'", filename));
+
+	/* Use the compiled copy if the text hasn't changed since it was made */
+	p->cached = FALSE;
+	if (ANGBAND_DIR_USER) {
+		path_build(raw, sizeof(raw), ANGBAND_DIR_USER,
+			format("data" PATH_SEP "%s.raw", filename));
+		hash = raw_file_hash(p, fh);
+
+		p->cached = raw_parse(p, raw, hash, &r);
+		if (p->cached) {
+			file_close(fh);
+			return r;
+		}
+
+		p->raw_len = 0;
+		p->raw_size = 4096;
+		p->raw_count = 0;
+		p->raw = mem_alloc(p->raw_size);
+	}
+
 	while (file_getl(fh, buf, sizeof(buf))) {
 		r = parser_parse(p, buf);
 		if (r)
 			break;
 	}
 	file_close(fh);
+
+	/* Compile the file for next time */
+	if (p->raw) {
+		if (!r)
+			raw_save(p, raw, hash);
+		FREE(p->raw);
+	}
+
 	return r;
 }
 
+bool parser_cached(struct parser *p) {
+	return p->cached;
+}
+
 void cleanup_parser(struct file_parser *fp)
 {
 	fp->cleanup();
@@ -134,6 +134,11 @@ extern void parser_setstate(struct parser *p, unsigned int col, const char *msg)
 
 errr run_parser(struct file_parser *fp);
 errr parse_file(struct parser *p, const char *filename);
+
+/** Returns whether the last parse_file() used the file's compiled copy
+ * rather than its text. */
+bool parser_cached(struct parser *p);
+
 void cleanup_parser(struct file_parser *fp);
 int lookup_flag(const char **flag_table, const char *flag_name);
 errr grab_flag(bitflag *flags, const size_t size, const char **flag_table, const char *flag_name);
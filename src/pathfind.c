@@ -19,24 +19,40 @@
 
 #include "angband.h"
 #include "cave.h"
+#include "pathfind.h"
 #include "squelch.h"
 
 /****** Pathfinding code ******/
 
-/* Maximum size around the player to consider in the pathfinder */
-#define MAX_PF_RADIUS 50
-
 /* Maximum distance to consider in the pathfinder */
 #define MAX_PF_LENGTH 250
 
+/* Grids are numbered y * DUNGEON_WID + x in the search arrays */
+#define PF_GRIDS (DUNGEON_HGT * DUNGEON_WID)
+
 
-static int terrain[MAX_PF_RADIUS][MAX_PF_RADIUS];
 static char pf_result[MAX_PF_LENGTH];
 static int pf_result_index;
 
-static int ox, oy, ex, ey;
 static int dir_search[8] = {2,4,6,8,1,3,7,9};
 
+/* Steps from the start, and the direction of the last one, for each grid */
+static u16b pf_cost[PF_GRIDS];
+static byte pf_dir[PF_GRIDS];
+
+/* The search which last reached each grid, so nothing needs clearing */
+static u32b pf_stamp[PF_GRIDS];
+static u32b pf_search;
+
+/*
+ * Open grids, as a binary heap ordered by pf_key[]. pf_heap_pos[] gives
+ * each grid's place in the heap, or -1 once it has been expanded.
+ */
+static int pf_heap[PF_GRIDS];
+static int pf_heap_pos[PF_GRIDS];
+static int pf_key[PF_GRIDS];
+static int pf_heap_size;
+
 
 static bool is_valid_pf(int y, int x)
 {
@@ -47,137 +63,179 @@ static bool is_valid_pf(int y, int x)
 	return (cave_floor_bold(y, x));
 }
 
-static void fill_terrain_info(void)
+static void pf_heap_place(int i, int grid)
+{
+	pf_heap[i] = grid;
+	pf_heap_pos[grid] = i;
+}
+
+static void pf_heap_up(int i)
 {
-	int i, j;
+	int grid = pf_heap[i];
+
+	while (i > 0 && pf_key[pf_heap[(i - 1) / 2]] > pf_key[grid])
+	{
+		pf_heap_place(i, pf_heap[(i - 1) / 2]);
+		i = (i - 1) / 2;
+	}
+
+	pf_heap_place(i, grid);
+}
+
+static int pf_heap_pop(void)
+{
+	int top = pf_heap[0];
+	int grid = pf_heap[--pf_heap_size];
+	int i = 0;
+
+	while (2 * i + 1 < pf_heap_size)
+	{
+		int child = 2 * i + 1;
 
-	ox = MAX(p_ptr->px - MAX_PF_RADIUS / 2, 0);
-	oy = MAX(p_ptr->py - MAX_PF_RADIUS / 2, 0);
+		if (child + 1 < pf_heap_size &&
+				pf_key[pf_heap[child + 1]] < pf_key[pf_heap[child]])
+			child++;
 
-	ex = MIN(p_ptr->px + MAX_PF_RADIUS / 2 - 1, DUNGEON_WID);
-	ey = MIN(p_ptr->py + MAX_PF_RADIUS / 2 - 1, DUNGEON_HGT);
+		if (pf_key[pf_heap[child]] >= pf_key[grid]) break;
 
-	for (i = 0; i < MAX_PF_RADIUS * MAX_PF_RADIUS; i++)
-		terrain[0][i] = -1;
+		pf_heap_place(i, pf_heap[child]);
+		i = child;
+	}
 
-	for (j = oy; j < ey; j++)
-		for (i = ox; i < ex; i++)
-			if (is_valid_pf(j, i))
-				terrain[j - oy][i - ox] = MAX_PF_LENGTH;
+	if (pf_heap_size) pf_heap_place(i, grid);
 
-	terrain[p_ptr->py - oy][p_ptr->px - ox] = 1;
+	pf_heap_pos[top] = -1;
+	return top;
 }
 
-#define MARK_DISTANCE(c,d) if ((c <= MAX_PF_LENGTH) && (c > d)) { c = d; try_again = (TRUE); }
+/*
+ * Record that grid can be reached in cost steps, the last one in direction
+ * dir, and queue it for expansion.
+ *
+ * Every step costs one turn, diagonal or not, so the octile distance to the
+ * goal reduces to the larger of the two offsets. Ties go to the grid nearer
+ * the goal, which keeps the search from flooding open rooms.
+ */
+static void pf_reach(int grid, int cost, int dir, struct loc to)
+{
+	int dx = ABS(grid % DUNGEON_WID - to.x);
+	int dy = ABS(grid / DUNGEON_WID - to.y);
+	int h = MAX(dx, dy);
+	bool queued = (pf_stamp[grid] == pf_search);
+
+	pf_stamp[grid] = pf_search;
+	pf_cost[grid] = cost;
+	pf_dir[grid] = dir;
+	pf_key[grid] = (cost + h) * DUNGEON_WID + h;
+
+	if (!queued) pf_heap_place(pf_heap_size++, grid);
+	pf_heap_up(pf_heap_pos[grid]);
+}
 
-bool findpath(int y, int x)
+/*
+ * Find a shortest path from one grid to another, using A* over the grids
+ * the player may walk through: anything not known to be a wall. The goal
+ * grid itself is always allowed.
+ *
+ * On success, the directions of the steps are written to path as the
+ * characters '1' to '9', last step first, and the number of steps is
+ * returned. Returns -1 if either grid is out of bounds or the goal cannot
+ * be reached in max steps or fewer.
+ */
+int pathfind_path(struct loc from, struct loc to, char *path, int max)
 {
-	int i, j, k, dir;
-	bool try_again;
-	int cur_distance;
+	int start, goal, grid, n;
 
-	fill_terrain_info();
+	if (!in_bounds_fully(from.y, from.x) || !in_bounds_fully(to.y, to.x))
+		return -1;
 
-	terrain[p_ptr->py - oy][p_ptr->px - ox] = 1;
+	start = from.y * DUNGEON_WID + from.x;
+	goal = to.y * DUNGEON_WID + to.x;
 
-	if ((x >= ox) && (x < ex) && (y >= oy) && (y < ey))
+	/* Start a new search, forgetting the old ones if the stamp wraps */
+	if (++pf_search == 0)
 	{
-		if ((cave->m_idx[y][x] > 0) && (cave_monster_at(cave, y, x)->ml))
-		{
-			terrain[y - oy][x - ox] = MAX_PF_LENGTH;
-		}
+		memset(pf_stamp, 0, sizeof(pf_stamp));
+		pf_search = 1;
+	}
 
-#if 0
-		else if (terrain[y-oy][x-ox] != MAX_PF_LENGTH)
-		{
-		   bell("Target blocked");
-		   return (FALSE);
-		}
-#endif
+	pf_heap_size = 0;
+	pf_reach(start, 0, 5, to);
 
-		terrain[y - oy][x - ox] = MAX_PF_LENGTH;
-	}
-	else
+	while (pf_heap_size)
 	{
-		bell("Target out of range.");
-		return (FALSE);
-	}
+		int y, x, k;
 
-	/* 
-	 * And now starts the very naive and very 
-	 * inefficient pathfinding algorithm
-	 */
-	do
-	{
-		try_again = FALSE;
+		grid = pf_heap_pop();
+		if (grid == goal) break;
+
+		/* Too far */
+		if (pf_cost[grid] >= max) continue;
+
+		y = grid / DUNGEON_WID;
+		x = grid % DUNGEON_WID;
 
-		for (j = oy + 1; j < ey - 1; j++)
+		for (k = 0; k < 8; k++)
 		{
-			for (i = ox + 1; i < ex - 1; i++)
-			{
-				cur_distance = terrain[j - oy][i - ox] + 1;
+			int dir = dir_search[k];
+			int ny = y + ddy[dir];
+			int nx = x + ddx[dir];
+			int next = ny * DUNGEON_WID + nx;
 
-				if ((cur_distance > 0) && (cur_distance < MAX_PF_LENGTH))
-				{
-					for (dir = 1; dir < 10; dir++)
-					{
-						if (dir == 5)
-							dir++;
+			if (!in_bounds_fully(ny, nx)) continue;
 
-						MARK_DISTANCE(terrain[j - oy + ddy[dir]][i - ox + ddx[dir]], cur_distance);
-					}
-				}
+			if (pf_stamp[next] == pf_search)
+			{
+				/* Already expanded, or already as close */
+				if (pf_heap_pos[next] < 0) continue;
+				if (pf_cost[next] <= pf_cost[grid] + 1) continue;
+			}
+			else if (next != goal && !is_valid_pf(ny, nx))
+			{
+				continue;
 			}
-		}
-
-		if (terrain[y - oy][x - ox] < MAX_PF_LENGTH)
-			try_again = (FALSE);
 
+			pf_reach(next, pf_cost[grid] + 1, dir, to);
+		}
 	}
-	while (try_again);
 
-	/* Failure */
-	if (terrain[y - oy][x - ox] == MAX_PF_LENGTH)
+	if (pf_stamp[goal] != pf_search) return -1;
+
+	/* Walk back from the goal */
+	n = 0;
+	for (grid = goal; grid != start; )
 	{
-		bell("Target space unreachable.");
-		return (FALSE);
+		int dir = pf_dir[grid];
+
+		path[n++] = '0' + (char)dir;
+		grid -= ddy[dir] * DUNGEON_WID + ddx[dir];
 	}
 
-	/* Success */
-	i = x;
-	j = y;
+	return n;
+}
 
-	pf_result_index = 0;
+bool findpath(int y, int x)
+{
+	int n;
 
-	while ((i != p_ptr->px) || (j != p_ptr->py))
+	if (!in_bounds_fully(y, x))
 	{
-		cur_distance = terrain[j - oy][i - ox] - 1;
-		for (k = 0; k < 8; k++)
-		{
-			dir = dir_search[k];
-			if (terrain[j - oy + ddy[dir]][i - ox + ddx[dir]] == cur_distance)
-				break;
-		}
-
-		/* Should never happend */
-		if (dir == 10)
-		{
-			bell("Wtf ?");
-			return (FALSE);
-		}
+		bell("Target out of range.");
+		return (FALSE);
+	}
 
-		else if (dir == 5)
-		{
-			bell("Heyyy !");
-			return (FALSE);
-		}
+	n = pathfind_path(loc(p_ptr->px, p_ptr->py), loc(x, y), pf_result,
+		MAX_PF_LENGTH);
 
-		pf_result[pf_result_index++] = '0' + (char)(10 - dir);
-		i += ddx[dir];
-		j += ddy[dir];
+	/* Failure */
+	if (n < 0)
+	{
+		bell("Target space unreachable.");
+		return (FALSE);
 	}
 
-	pf_result_index--;
+	/* Success */
+	pf_result_index = n - 1;
 
 	return (TRUE);
 }
@@ -6,5 +6,6 @@
 #include "z-type.h"
 
 extern int pathfind_direction_to(struct loc from, struct loc to);
+extern int pathfind_path(struct loc from, struct loc to, char *path, int max);
 
 #endif /* !PATHFIND_H */
@@ -20,6 +20,7 @@
 #include "cave.h"
 #include "history.h"
 #include "monster/mon-make.h"
+#include "monster/mon-util.h"
 #include "monster/monster.h"
 #include "option.h"
 #include "savefile.h"
@@ -791,7 +792,7 @@ void wr_monsters(void)
 		wr_s16b(m_ptr->hp);
 		wr_s16b(m_ptr->maxhp);
 		wr_byte(m_ptr->mspeed);
-		wr_byte(m_ptr->energy);
+		wr_byte(monster_energy(cave, m_ptr));
 		wr_byte(MON_TMD_MAX);
 
 		for (j = 0; j < MON_TMD_MAX; j++)
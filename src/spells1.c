@@ -1284,8 +1284,8 @@ static bool project_f(int who, int r, int y, int x, int dam, int typ, bool obvio
 			/* Update the visuals */
 			p_ptr->update |= (PU_UPDATE_VIEW | PU_MONSTERS);
 
-			/* Fully update the flow */
-			p_ptr->update |= (PU_FORGET_FLOW | PU_UPDATE_FLOW);
+			/* Update the flow */
+			p_ptr->update |= (PU_UPDATE_FLOW);
 
 			break;
 		}
@@ -332,6 +332,7 @@ static void uncurse_object(object_type *o_ptr)
 	create_mask(f, FALSE, OFT_CURSE, OFT_MAX);
 
 	of_diff(o_ptr->flags, f);
+	object_flags_forget(o_ptr);
 }
 
 
@@ -2974,6 +2975,7 @@ bool curse_armor(void)
 
 		/* Curse it */
 		flags_set(o_ptr->flags, OF_SIZE, OF_LIGHT_CURSE, OF_HEAVY_CURSE, FLAG_END);
+		object_flags_forget(o_ptr);
 
 		/* Recalculate bonuses */
 		p_ptr->update |= (PU_BONUS);
@@ -3029,6 +3031,7 @@ bool curse_weapon(void)
 
 		/* Curse it */
 		flags_set(o_ptr->flags, OF_SIZE, OF_LIGHT_CURSE, OF_HEAVY_CURSE, FLAG_END);
+		object_flags_forget(o_ptr);
 
 		/* Recalculate bonuses */
 		p_ptr->update |= (PU_BONUS);
@@ -29,6 +29,16 @@ static sqlite3 *db;
 static char *ANGBAND_DIR_STATS;
 static char *db_filename;
 
+/* Prepared statements kept for the life of the connection, keyed by SQL */
+struct stats_db_cached_stmt {
+	char *sql_str;
+	sqlite3_stmt *sql_stmt;
+};
+
+static struct stats_db_cached_stmt *stmt_cache;
+static size_t stmt_cache_count;
+static size_t stmt_cache_size;
+
 /* Utility functions */
 static bool stats_make_output_dir(void) {
 	size_t size = strlen(ANGBAND_DIR_USER) + strlen(PATH_SEP) + 6;
@@ -75,6 +85,11 @@ bool stats_db_open(void) {
 		sqlite3_close(db);
 		return false;
 	}
+
+	/* The database is only written by this process and can be regenerated,
+	 * so trade durability for write speed */
+	sqlite3_exec(db, "PRAGMA journal_mode=WAL;", NULL, NULL, NULL);
+	sqlite3_exec(db, "PRAGMA synchronous=NORMAL;", NULL, NULL, NULL);
 	
 	return true;	
 }
@@ -84,6 +99,16 @@ bool stats_db_open(void) {
  * module variables.
  */
 bool stats_db_close(void) {
+	size_t i;
+
+	for (i = 0; i < stmt_cache_count; i++) {
+		sqlite3_finalize(stmt_cache[i].sql_stmt);
+		string_free(stmt_cache[i].sql_str);
+	}
+	mem_free(stmt_cache);
+	stmt_cache = NULL;
+	stmt_cache_count = stmt_cache_size = 0;
+
 	sqlite3_close(db);
 	mem_free(ANGBAND_DIR_STATS);
 	mem_free(db_filename);
@@ -120,6 +145,69 @@ int stats_db_stmt_prep(sqlite3_stmt **sql_stmt, char *sql_str) {
 		sql_stmt, NULL);
 }
 
+/**
+ * Fetch a prepared statement for sql_str, preparing it on first use. The
+ * statement belongs to the cache and is finalized by stats_db_close(), so
+ * the caller should reset it after use but never finalize it. Returns 0 on
+ * success or a sqlite3 error code on failure.
+ */
+
+int stats_db_stmt_cached(sqlite3_stmt **sql_stmt, const char *sql_str) {
+	size_t i;
+	int err;
+
+	assert(sql_stmt != NULL);
+
+	for (i = 0; i < stmt_cache_count; i++) {
+		if (streq(stmt_cache[i].sql_str, sql_str)) {
+			*sql_stmt = stmt_cache[i].sql_stmt;
+
+			/* Recover from a step that failed before its reset */
+			return sqlite3_reset(*sql_stmt);
+		}
+	}
+
+	err = sqlite3_prepare_v2(db, sql_str, strlen(sql_str), sql_stmt, NULL);
+	if (err) return err;
+
+	if (stmt_cache_count == stmt_cache_size) {
+		stmt_cache_size = stmt_cache_size ? stmt_cache_size * 2 : 16;
+		stmt_cache = mem_realloc(stmt_cache,
+			stmt_cache_size * sizeof(*stmt_cache));
+	}
+
+	stmt_cache[stmt_cache_count].sql_str = string_make(sql_str);
+	stmt_cache[stmt_cache_count].sql_stmt = *sql_stmt;
+	stmt_cache_count++;
+
+	return SQLITE_OK;
+}
+
+/**
+ * Start a batch of writes. Everything up to stats_db_batch_commit() goes
+ * into a single transaction, so the batch costs one journal sync however
+ * many rows it touches. Returns 0 on success or a sqlite3 error code.
+ */
+
+int stats_db_batch_begin(void) {
+	return sqlite3_exec(db, "BEGIN TRANSACTION;", NULL, NULL, NULL);
+}
+
+/**
+ * Commit a batch started with stats_db_batch_begin(), or roll it back if
+ * the writes failed (err is non-zero). Returns err if it was set, or else
+ * the result of the commit.
+ */
+
+int stats_db_batch_commit(int err) {
+	if (err) {
+		sqlite3_exec(db, "ROLLBACK;", NULL, NULL, NULL);
+		return err;
+	}
+
+	return sqlite3_exec(db, "COMMIT;", NULL, NULL, NULL);
+}
+
 /**
  * Utility function for binding many ints at once. The offset argument 
  * should be the number of columns to skip before starting to bind. 
@@ -0,0 +1,131 @@
+/* cave/los
+ *
+ * Checks that the line of sight cache gives the same answers as working
+ * them out afresh, as the terrain changes under it
+ */
+
+#include "unit-test.h"
+#include "angband.h"
+#include "cave.h"
+
+#include <time.h>
+
+#define LOS_CHANGES	2000
+#define LOS_ASKS	200
+#define BENCH_TURNS	2000
+#define BENCH_CASTERS	40
+
+int setup_tests(void **state) {
+	z_info = mem_zalloc(sizeof(maxima));
+	z_info->m_max = 1;
+	cave = cave_new();
+
+	Rand_quick = FALSE;
+	Rand_state_init(1234);
+	return 0;
+}
+
+int teardown_tests(void *state) {
+	cave_free(cave);
+	cave = NULL;
+	FREE(z_info);
+	return 0;
+}
+
+/* A level walled at the edges, with walls scattered over one in `wall` */
+static void random_level(int wall) {
+	int y, x;
+
+	for (y = 0; y < DUNGEON_HGT; y++)
+		for (x = 0; x < DUNGEON_WID; x++)
+			cave_set_feat(cave, y, x, (!in_bounds_fully(y, x) ||
+				one_in_(wall)) ? FEAT_WALL_SOLID : FEAT_FLOOR);
+}
+
+/* A random grid, and one near it */
+static void random_pair(int *y1, int *x1, int *y2, int *x2) {
+	*y1 = randint1(DUNGEON_HGT - 2);
+	*x1 = randint1(DUNGEON_WID - 2);
+	*y2 = MAX(1, MIN(DUNGEON_HGT - 2, *y1 + randint0(2 * MAX_RANGE + 1) - MAX_RANGE));
+	*x2 = MAX(1, MIN(DUNGEON_WID - 2, *x1 + randint0(2 * MAX_RANGE + 1) - MAX_RANGE));
+}
+
+int test_changes(void *state) {
+	int i, j, y1, x1, y2, x2, y[LOS_ASKS][2], x[LOS_ASKS][2];
+
+	random_level(6);
+	for (j = 0; j < LOS_ASKS; j++)
+		random_pair(&y[j][0], &x[j][0], &y[j][1], &x[j][1]);
+
+	for (i = 0; i < LOS_CHANGES; i++) {
+		/* Knock down or put up a wall, or a whole run of them */
+		for (j = one_in_(50) ? LOS_CACHE_CHANGES + 5 : 1; j > 0; j--) {
+			int y = randint1(DUNGEON_HGT - 2), x = randint1(DUNGEON_WID - 2);
+
+			cave_set_feat(cave, y, x, cave_floor_bold(y, x) ?
+				FEAT_RUBBLE : FEAT_FLOOR);
+		}
+
+		for (j = 0; j < LOS_ASKS; j++) {
+			bool sight, proj;
+
+			/* Mostly ask about the same pairs again */
+			if (one_in_(4)) {
+				random_pair(&y1, &x1, &y2, &x2);
+			} else {
+				y1 = y[j][0], x1 = x[j][0];
+				y2 = y[j][1], x2 = x[j][1];
+			}
+
+			sight = los(y1, x1, y2, x2);
+			proj = projectable(y1, x1, y2, x2, PROJECT_NONE);
+
+			cave_forget_los(cave);
+			eq(los(y1, x1, y2, x2), sight);
+			eq(projectable(y1, x1, y2, x2, PROJECT_NONE), proj);
+		}
+	}
+
+	ok;
+}
+
+/* Microbenchmark: BENCH_CASTERS monsters looking at the player every turn */
+int test_bench(void *state) {
+	clock_t start, mid, end;
+	int turn, i, y[BENCH_CASTERS], x[BENCH_CASTERS], seen = 0;
+
+	random_level(8);
+	for (i = 0; i < BENCH_CASTERS; i++) {
+		int y2, x2;
+		random_pair(&y[i], &x[i], &y2, &x2);
+	}
+
+	start = clock();
+	for (turn = 0; turn < BENCH_TURNS; turn++)
+		for (i = 0; i < BENCH_CASTERS; i++)
+			seen += projectable(y[i], x[i], 30, 90, PROJECT_NONE);
+	mid = clock();
+	for (turn = 0; turn < BENCH_TURNS; turn++) {
+		for (i = 0; i < BENCH_CASTERS; i++) {
+			cave_forget_los(cave);
+			seen -= projectable(y[i], x[i], 30, 90, PROJECT_NONE);
+		}
+	}
+	end = clock();
+
+	eq(seen, 0);
+
+	if (verbose)
+		printf("    %d turns: %.3fs cached, %.3fs uncached\n", BENCH_TURNS,
+		       (double)(mid - start) / CLOCKS_PER_SEC,
+		       (double)(end - mid) / CLOCKS_PER_SEC);
+
+	ok;
+}
+
+const char *suite_name = "cave/los";
+struct test tests[] = {
+	{ "changes", test_changes },
+	{ "bench", test_bench },
+	{ NULL, NULL }
+};
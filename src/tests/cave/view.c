@@ -0,0 +1,134 @@
+/* cave/view */
+
+#include "unit-test.h"
+#include "angband.h"
+#include "cave.h"
+
+#include <time.h>
+
+#define BENCH_VIEWS	20000
+
+int setup_tests(void **state) {
+	z_info = mem_zalloc(sizeof(maxima));
+	z_info->m_max = 1;
+	temp_g = C_ZNEW(TEMP_MAX, u16b);
+	cave = cave_new();
+
+	if (vinfo_init()) return 1;
+
+	/* Nothing becomes "seen", so the display is never touched */
+	p_ptr->timed[TMD_BLIND] = 1;
+	return 0;
+}
+
+int teardown_tests(void *state) {
+	cave_free(cave);
+	cave = NULL;
+	FREE(temp_g);
+	FREE(z_info);
+	return 0;
+}
+
+/* An open level walled at the edges, with a pillar every few grids */
+static void pillar_level(int spacing) {
+	int y, x;
+
+	for (y = 0; y < DUNGEON_HGT; y++) {
+		for (x = 0; x < DUNGEON_WID; x++) {
+			bool edge = !in_bounds_fully(y, x);
+			bool pillar = spacing && (y % spacing == 0) && (x % spacing == 0);
+
+			cave_set_feat(cave, y, x, (edge || pillar) ? FEAT_PERM_SOLID : FEAT_FLOOR);
+			cave->info[y][x] &= ~(CAVE_VIEW | CAVE_SEEN | CAVE_TEMP);
+		}
+	}
+}
+
+int test_open(void *state) {
+	pillar_level(0);
+	p_ptr->py = 30;
+	p_ptr->px = 90;
+	forget_view();
+	update_view();
+
+	require(cave->info[30][90] & CAVE_VIEW);
+	require(cave->info[30][90 + MAX_SIGHT - 1] & CAVE_VIEW);
+	require(cave->info[30 - 10][90 + 10] & CAVE_VIEW);
+	require(!(cave->info[30][90 + MAX_SIGHT + 2] & CAVE_VIEW));
+	require(!(cave->info[30][90] & CAVE_SEEN));
+	ok;
+}
+
+int test_wall(void *state) {
+	pillar_level(0);
+	cave_set_feat(cave, 30, 92, FEAT_WALL_SOLID);
+	p_ptr->py = 30;
+	p_ptr->px = 90;
+	forget_view();
+	update_view();
+
+	/* The wall is seen but hides the grids straight behind it */
+	require(cave->info[30][92] & CAVE_VIEW);
+	require(!(cave->info[30][94] & CAVE_VIEW));
+	require(cave->info[31][94] & CAVE_VIEW);
+	ok;
+}
+
+int test_change(void *state) {
+	pillar_level(0);
+	p_ptr->py = 30;
+	p_ptr->px = 90;
+	forget_view();
+	update_view();
+	require(cave->info[30][94] & CAVE_VIEW);
+
+	/* A new wall is noticed without forgetting the view */
+	cave_set_feat(cave, 30, 92, FEAT_WALL_SOLID);
+	update_view();
+	require(!(cave->info[30][94] & CAVE_VIEW));
+
+	/* And so is its removal, after standing still */
+	update_view();
+	cave_set_feat(cave, 30, 92, FEAT_FLOOR);
+	update_view();
+	require(cave->info[30][94] & CAVE_VIEW);
+	ok;
+}
+
+/* Microbenchmark: BENCH_VIEWS view updates while walking a pillared room,
+ * then while standing still */
+int test_bench(void *state) {
+	clock_t start, mid, end;
+	int i;
+
+	pillar_level(4);
+	forget_view();
+
+	start = clock();
+	for (i = 0; i < BENCH_VIEWS; i++) {
+		p_ptr->py = 10 + (i / 150) % 45;
+		p_ptr->px = 25 + i % 150;
+		if (cave->info[p_ptr->py][p_ptr->px] & CAVE_WALL) p_ptr->px++;
+		update_view();
+	}
+	mid = clock();
+	for (i = 0; i < BENCH_VIEWS; i++)
+		update_view();
+	end = clock();
+
+	if (verbose)
+		printf("    %d views: %.3fs walking, %.3fs still\n", BENCH_VIEWS,
+		       (double)(mid - start) / CLOCKS_PER_SEC,
+		       (double)(end - mid) / CLOCKS_PER_SEC);
+
+	ok;
+}
+
+const char *suite_name = "cave/view";
+struct test tests[] = {
+	{ "open", test_open },
+	{ "wall", test_wall },
+	{ "change", test_change },
+	{ "bench", test_bench },
+	{ NULL, NULL }
+};
@@ -0,0 +1,223 @@
+/* keymap/keymap
+ *
+ * Loads a large generated pref file of keymaps and checks that every trigger
+ * finds its action, that later keymaps replace earlier ones, and that
+ * removing keymaps and dumping them still work
+ */
+
+#include "unit-test.h"
+#include "angband.h"
+#include "keymap.h"
+#include "prefs.h"
+
+#include <time.h>
+
+#define KEYMAP_FILE	"keymap-test.prf"
+#define DUMP_FILE	"keymap-dump.prf"
+#define REPLACED	100
+#define BENCH_ROUNDS	200
+
+static const char *mod_chars = "SAMK";
+static const char *key_chars =
+	"abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789";
+
+/* Every combination of modifiers with every key, in each mode */
+#define KEYS_PER_MODE	(16 * 62)
+
+/* The trigger of each generated keymap, as text */
+static char triggers[KEYS_PER_MODE][16];
+
+int setup_tests(void **state) {
+	int i;
+
+	for (i = 0; i < KEYS_PER_MODE; i++) {
+		int mods = i / 62, m;
+		size_t end = 0;
+
+		triggers[i][0] = '\0';
+		if (mods) {
+			strnfcat(triggers[i], sizeof(triggers[i]), &end, "{");
+			for (m = 0; m < 4; m++)
+				if (mods & (1 << m))
+					strnfcat(triggers[i], sizeof(triggers[i]), &end, "%c",
+						mod_chars[m]);
+			strnfcat(triggers[i], sizeof(triggers[i]), &end, "}");
+		}
+		strnfcat(triggers[i], sizeof(triggers[i]), &end, "%c", key_chars[i % 62]);
+	}
+
+	ANGBAND_DIR_PREF = string_make(".");
+	ANGBAND_DIR_USER = string_make(".");
+	return 0;
+}
+
+int teardown_tests(void *state) {
+	keymap_free();
+	file_delete(KEYMAP_FILE);
+	file_delete(DUMP_FILE);
+	string_free(ANGBAND_DIR_PREF);
+	string_free(ANGBAND_DIR_USER);
+	return 0;
+}
+
+/* The keypress a trigger turns into */
+static struct keypress trigger_key(int i) {
+	struct keypress tmp[2];
+
+	keypress_from_text(tmp, N_ELEMENTS(tmp), triggers[i]);
+	return tmp[0];
+}
+
+/* Whether trigger i in the given mode finds the expected action */
+static bool finds(int mode, int i, const char *expect) {
+	const struct keypress *act = keymap_find(mode, trigger_key(i));
+	char buf[64] = "";
+
+	if (!act) return expect == NULL;
+	if (!expect) return FALSE;
+
+	keypress_to_text(buf, sizeof(buf), act, FALSE);
+	return streq(buf, expect);
+}
+
+/* The first REPLACED triggers in each mode are given new actions at the end */
+static void write_keymaps(void) {
+	ang_file *fh = file_open(KEYMAP_FILE, MODE_WRITE, FTYPE_TEXT);
+	int mode, i;
+
+	for (mode = 0; mode < KEYMAP_MODE_MAX; mode++)
+		for (i = 0; i < KEYS_PER_MODE; i++)
+			file_putf(fh, "A:n%d\nC:%d:%s\n\n", mode * KEYS_PER_MODE + i, mode,
+				triggers[i]);
+
+	for (mode = 0; mode < KEYMAP_MODE_MAX; mode++)
+		for (i = 0; i < REPLACED; i++)
+			file_putf(fh, "A:r%d\nC:%d:%s\n\n", i, mode, triggers[i]);
+
+	file_close(fh);
+}
+
+int test_load(void *state) {
+	struct keypress none = { EVT_KBRD, '!', KC_MOD_KEYPAD };
+	int mode, i;
+
+	write_keymaps();
+	require(process_pref_file(KEYMAP_FILE, FALSE, TRUE));
+
+	for (mode = 0; mode < KEYMAP_MODE_MAX; mode++) {
+		for (i = 0; i < KEYS_PER_MODE; i++) {
+			if (i < REPLACED)
+				require(finds(mode, i, format("r%d", i)));
+			else
+				require(finds(mode, i,
+					format("n%d", mode * KEYS_PER_MODE + i)));
+		}
+	}
+
+	/* A key with no keymap */
+	require(!keymap_find(KEYMAP_MODE_ORIG, none));
+	ok;
+}
+
+/* Dumped keymaps come out newest first, replaced ones included */
+int test_dump(void *state) {
+	ang_file *fh = file_open(DUMP_FILE, MODE_WRITE, FTYPE_TEXT);
+	char line[1024];
+	int n = 0;
+
+	keymap_dump(fh);
+	file_close(fh);
+
+	fh = file_open(DUMP_FILE, MODE_READ, -1);
+	require(fh);
+	while (file_getl(fh, line, sizeof(line))) {
+		int i;
+
+		if (line[0] != 'C') continue;
+
+		if (n < REPLACED)
+			i = REPLACED - 1 - n;
+		else
+			i = KEYS_PER_MODE - 1 - (n - REPLACED);
+		require(streq(line, format("C:%d:%s", KEYMAP_MODE_ORIG, triggers[i])));
+		n++;
+	}
+	file_close(fh);
+
+	eq(n, KEYS_PER_MODE);
+	ok;
+}
+
+int test_remove(void *state) {
+	int i;
+
+	for (i = 0; i < KEYS_PER_MODE; i += 2)
+		require(keymap_remove(KEYMAP_MODE_ROGUE, trigger_key(i)));
+	require(!keymap_remove(KEYMAP_MODE_ROGUE, trigger_key(0)));
+
+	for (i = 0; i < KEYS_PER_MODE; i++) {
+		if (i % 2 == 0)
+			require(finds(KEYMAP_MODE_ROGUE, i, NULL));
+		else if (i < REPLACED)
+			require(finds(KEYMAP_MODE_ROGUE, i, format("r%d", i)));
+		else
+			require(finds(KEYMAP_MODE_ROGUE, i,
+				format("n%d", KEYS_PER_MODE + i)));
+	}
+
+	/* The other mode is untouched */
+	require(finds(KEYMAP_MODE_ORIG, 0, "r0"));
+	require(finds(KEYMAP_MODE_ORIG, REPLACED, format("n%d", REPLACED)));
+
+	/* Nothing is left behind */
+	keymap_free();
+	for (i = 0; i < KEYS_PER_MODE; i++)
+		require(finds(KEYMAP_MODE_ORIG, i, NULL));
+	ok;
+}
+
+/* Microbenchmark: BENCH_ROUNDS lookups of every trigger, in the table and
+ * by walking a list of them the way keymap_find() used to */
+int test_bench(void *state) {
+	struct keypress keys[KEYS_PER_MODE];
+	clock_t start, mid, end;
+	int r, i, j, found = 0;
+
+	require(process_pref_file(KEYMAP_FILE, FALSE, TRUE));
+	for (i = 0; i < KEYS_PER_MODE; i++)
+		keys[i] = trigger_key(i);
+
+	start = clock();
+	for (r = 0; r < BENCH_ROUNDS; r++)
+		for (i = 0; i < KEYS_PER_MODE; i++)
+			if (keymap_find(KEYMAP_MODE_ORIG, keys[i])) found++;
+	mid = clock();
+	for (r = 0; r < BENCH_ROUNDS; r++) {
+		for (i = 0; i < KEYS_PER_MODE; i++) {
+			for (j = KEYS_PER_MODE - 1; j >= 0; j--)
+				if (keys[j].code == keys[i].code && keys[j].mods == keys[i].mods)
+					break;
+			if (j >= 0) found++;
+		}
+	}
+	end = clock();
+
+	eq(found, 2 * BENCH_ROUNDS * KEYS_PER_MODE);
+
+	if (verbose)
+		printf("    %d lookups: %.3fs hashed, %.3fs scanned\n",
+		       BENCH_ROUNDS * KEYS_PER_MODE,
+		       (double)(mid - start) / CLOCKS_PER_SEC,
+		       (double)(end - mid) / CLOCKS_PER_SEC);
+
+	ok;
+}
+
+const char *suite_name = "keymap/keymap";
+struct test tests[] = {
+	{ "load", test_load },
+	{ "dump", test_dump },
+	{ "remove", test_remove },
+	{ "bench", test_bench },
+	{ NULL, NULL },
+};
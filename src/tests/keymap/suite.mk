@@ -0,0 +1 @@
+TESTPROGS += keymap/keymap
@@ -0,0 +1,214 @@
+/* monster/alloc
+ *
+ * Checks that get_mon_num() picks monsters with the same odds as the
+ * original linear scan of the allocation table
+ */
+
+#include "unit-test.h"
+#include "test-utils.h"
+#include "monster/mon-make.h"
+
+#include <math.h>
+#include <time.h>
+
+#define ALLOC_DRAWS	100000
+#define BENCH_DRAWS	100000
+
+static u32b *count_new, *count_old;
+
+int setup_tests(void **state) {
+	int i;
+
+	read_edit_files();
+
+	/* As for a new character */
+	for (i = 1; i < z_info->r_max; i++) {
+		monster_race *r_ptr = &r_info[i];
+
+		r_ptr->cur_num = 0;
+		r_ptr->max_num = rf_has(r_ptr->flags, RF_UNIQUE) ? 1 : 100;
+	}
+	get_mon_num_reset();
+
+	count_new = mem_zalloc(z_info->r_max * sizeof(*count_new));
+	count_old = mem_zalloc(z_info->r_max * sizeof(*count_old));
+
+	Rand_quick = FALSE;
+	Rand_state_init(1234);
+	return 0;
+}
+
+int teardown_tests(void *state) {
+	mem_free(count_new);
+	mem_free(count_old);
+	return 0;
+}
+
+/* The original get_mon_num(), a cumulative scan over prob3 */
+static int old_get_mon_num_aux(long total, const alloc_entry *table) {
+	long value = randint0(total);
+	int i;
+
+	for (i = 0; i < alloc_race_size; i++) {
+		if (value < table[i].prob3) break;
+		value = value - table[i].prob3;
+	}
+
+	return i;
+}
+
+static s16b old_get_mon_num(int level) {
+	alloc_entry *table = alloc_race_table;
+	long total = 0L;
+	int i, j, p;
+
+	if (level > 0 && one_in_(NASTY_MON))
+		level += MIN(level / 4 + 2, MON_OOD_MAX);
+
+	for (i = 0; i < alloc_race_size; i++) {
+		monster_race *r_ptr;
+
+		if (table[i].level > level) break;
+		table[i].prob3 = 0;
+		if ((level > 0) && (table[i].level <= 0)) continue;
+
+		r_ptr = &r_info[table[i].index];
+		if (rf_has(r_ptr->flags, RF_UNIQUE) &&
+				r_ptr->cur_num >= r_ptr->max_num)
+			continue;
+		if (rf_has(r_ptr->flags, RF_FORCE_DEPTH) &&
+				r_ptr->level > p_ptr->depth)
+			continue;
+
+		table[i].prob3 = table[i].prob2;
+		total += table[i].prob3;
+	}
+
+	if (total <= 0) return 0;
+
+	i = old_get_mon_num_aux(total, table);
+	p = randint0(100);
+	if (p < 60) {
+		j = i;
+		i = old_get_mon_num_aux(total, table);
+		if (table[i].level < table[j].level) i = j;
+	}
+	if (p < 10) {
+		j = i;
+		i = old_get_mon_num_aux(total, table);
+		if (table[i].level < table[j].level) i = j;
+	}
+
+	return table[i].index;
+}
+
+/* Two-sample chi-squared between the old and new pickers at one depth,
+ * with a bound about five standard deviations above the mean */
+static bool same_odds(int level) {
+	double chi = 0.0, bound;
+	int i, bins = 0;
+
+	p_ptr->depth = level;
+	memset(count_new, 0, z_info->r_max * sizeof(*count_new));
+	memset(count_old, 0, z_info->r_max * sizeof(*count_old));
+
+	for (i = 0; i < ALLOC_DRAWS; i++) {
+		count_new[get_mon_num(level)]++;
+		count_old[old_get_mon_num(level)]++;
+	}
+
+	for (i = 0; i < z_info->r_max; i++) {
+		double a = count_new[i], b = count_old[i];
+
+		if (a + b == 0) continue;
+		chi += (a - b) * (a - b) / (a + b);
+		bins++;
+	}
+
+	bound = (bins - 1) + 5 * sqrt(2.0 * (bins - 1));
+	if (verbose)
+		printf("    depth %2d: chi-squared %.1f over %d races (bound %.1f)\n",
+		       level, chi, bins, bound);
+	return chi < bound;
+}
+
+int test_odds(void *state) {
+	require(same_odds(1));
+	require(same_odds(10));
+	require(same_odds(30));
+	require(same_odds(60));
+	require(same_odds(98));
+	ok;
+}
+
+/* Uniques stop appearing once dead, and a hook narrows the choice */
+int test_reset(void *state) {
+	int i, r_idx = 0;
+
+	/* Find a shallow unique */
+	for (i = 0; i < alloc_race_size; i++) {
+		monster_race *r_ptr = &r_info[alloc_race_table[i].index];
+
+		if (rf_has(r_ptr->flags, RF_UNIQUE) && r_ptr->level > 0 &&
+				!rf_has(r_ptr->flags, RF_FORCE_DEPTH)) {
+			r_idx = alloc_race_table[i].index;
+			break;
+		}
+	}
+	require(r_idx);
+
+	p_ptr->depth = 20;
+	r_info[r_idx].max_num = 0;
+	get_mon_num_reset();
+	for (i = 0; i < ALLOC_DRAWS / 10; i++)
+		require(get_mon_num(20) != r_idx);
+	r_info[r_idx].max_num = 1;
+	get_mon_num_reset();
+	ok;
+}
+
+static bool only_dragons(int r_idx) {
+	return r_info[r_idx].d_char == 'd';
+}
+
+int test_hook(void *state) {
+	int i;
+
+	get_mon_num_hook = only_dragons;
+	get_mon_num_prep();
+	for (i = 0; i < ALLOC_DRAWS / 10; i++)
+		eq(r_info[get_mon_num(40)].d_char, 'd');
+
+	get_mon_num_hook = NULL;
+	get_mon_num_prep();
+	ok;
+}
+
+int test_bench(void *state) {
+	clock_t start, mid, end;
+	int i;
+
+	p_ptr->depth = 40;
+	start = clock();
+	for (i = 0; i < BENCH_DRAWS; i++)
+		old_get_mon_num(40);
+	mid = clock();
+	for (i = 0; i < BENCH_DRAWS; i++)
+		get_mon_num(40);
+	end = clock();
+
+	if (verbose)
+		printf("    %d picks: %.3fs scan, %.3fs alias\n", BENCH_DRAWS,
+		       (double)(mid - start) / CLOCKS_PER_SEC,
+		       (double)(end - mid) / CLOCKS_PER_SEC);
+	ok;
+}
+
+const char *suite_name = "monster/alloc";
+struct test tests[] = {
+	{ "odds", test_odds },
+	{ "reset", test_reset },
+	{ "hook", test_hook },
+	{ "bench", test_bench },
+	{ NULL, NULL }
+};
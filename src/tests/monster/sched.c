@@ -0,0 +1,205 @@
+/* monster/sched
+ *
+ * Checks that the monster schedule picks the same monsters, in the same
+ * order, as giving every monster its energy each turn and scanning them all
+ */
+
+#include "unit-test.h"
+#include "angband.h"
+#include "cave.h"
+#include "monster/mon-timed.h"
+#include "monster/mon-util.h"
+
+#include <time.h>
+
+#define SCHED_MONSTERS	1024
+#define SCHED_TURNS	5000
+#define BENCH_TURNS	20000
+
+/* The monsters as the original code saw them */
+static struct monster *shadow;
+
+/* Monster indexes picked in one pass, by each method */
+static int picked_new[SCHED_MONSTERS], picked_old[SCHED_MONSTERS];
+
+int setup_tests(void **state) {
+	z_info = mem_zalloc(sizeof(maxima));
+	z_info->m_max = SCHED_MONSTERS;
+	cave = cave_new();
+	shadow = C_ZNEW(SCHED_MONSTERS, struct monster);
+
+	Rand_quick = FALSE;
+	Rand_state_init(4321);
+	return 0;
+}
+
+int teardown_tests(void *state) {
+	mem_free(shadow);
+	cave_free(cave);
+	FREE(z_info);
+	return 0;
+}
+
+static void add_monster(int i) {
+	struct monster *m = cave_monster(cave, i);
+
+	WIPE(m, struct monster);
+	m->r_idx = 1;
+	m->midx = i;
+	m->mspeed = 100 + randint0(40);
+	m->energy = (byte)randint0(50);
+	COPY(&shadow[i], m, struct monster);
+	mon_sched_add(cave, m);
+}
+
+static void remove_monster(int i) {
+	mon_sched_remove(cave, cave_monster(cave, i));
+	WIPE(cave_monster(cave, i), struct monster);
+	WIPE(&shadow[i], struct monster);
+}
+
+static void set_timed(int i, int ef_idx, int value) {
+	cave_monster(cave, i)->m_timed[ef_idx] = value;
+	shadow[i].m_timed[ef_idx] = value;
+	mon_sched_update(cave, cave_monster(cave, i));
+}
+
+/* A pass of process_monsters() with the schedule */
+static int pass_new(byte min_energy) {
+	int i, n = 0;
+
+	for (i = mon_sched_next(cave, cave_monster_max(cave), min_energy); i;
+			i = mon_sched_next(cave, i, min_energy)) {
+		struct monster *m = cave_monster(cave, i);
+
+		monster_set_energy(cave, m, monster_energy(cave, m) - 100);
+		picked_new[n++] = i;
+	}
+
+	return n;
+}
+
+/* A pass of the original process_monsters() */
+static int pass_old(byte min_energy) {
+	int i, n = 0;
+
+	for (i = cave_monster_max(cave) - 1; i >= 1; i--) {
+		if (!shadow[i].r_idx) continue;
+		if (shadow[i].energy < min_energy) continue;
+		shadow[i].energy -= 100;
+		picked_old[n++] = i;
+	}
+
+	return n;
+}
+
+/* The original handing out of energy */
+static void tick_old(void) {
+	int i;
+
+	for (i = cave_monster_max(cave) - 1; i >= 1; i--) {
+		int mspeed = shadow[i].mspeed;
+
+		if (!shadow[i].r_idx) continue;
+		if (shadow[i].m_timed[MON_TMD_FAST]) mspeed += 10;
+		if (shadow[i].m_timed[MON_TMD_SLOW]) mspeed -= 10;
+		shadow[i].energy += extract_energy[mspeed];
+	}
+}
+
+/* Fill the list, with `live` monsters in every 100 slots */
+static void fill_level(int live) {
+	int i;
+
+	mon_sched_wipe(cave);
+	cave->mon_max = SCHED_MONSTERS;
+	for (i = 1; i < SCHED_MONSTERS; i++) {
+		if (randint0(100) >= live) {
+			WIPE(cave_monster(cave, i), struct monster);
+			WIPE(&shadow[i], struct monster);
+		} else {
+			add_monster(i);
+		}
+	}
+}
+
+/* Whether both methods just picked the same monsters */
+static bool same_pass(byte min_energy) {
+	int n = pass_new(min_energy);
+
+	return pass_old(min_energy) == n &&
+		!memcmp(picked_new, picked_old, n * sizeof(int));
+}
+
+int test_order(void *state) {
+	int turn, i;
+
+	fill_level(75);
+
+	for (turn = 0; turn < SCHED_TURNS; turn++) {
+		int j = randint1(SCHED_MONSTERS - 1);
+
+		/* Births, deaths, haste and slowness */
+		if (!shadow[j].r_idx)
+			add_monster(j);
+		else if (one_in_(3))
+			remove_monster(j);
+		else
+			set_timed(j, one_in_(2) ? MON_TMD_FAST : MON_TMD_SLOW,
+				one_in_(2) ? 0 : 10);
+
+		/* Monsters with more energy than the player, then the rest */
+		require(same_pass(101 + randint0(60)));
+		require(same_pass(100));
+
+		mon_sched_tick(cave);
+		tick_old();
+
+		for (i = 1; i < SCHED_MONSTERS; i++)
+			eq(monster_energy(cave, cave_monster(cave, i)), shadow[i].energy);
+	}
+
+	ok;
+}
+
+/* Microbenchmark: BENCH_TURNS game turns of monster passes and energy */
+int test_bench(void *state) {
+	clock_t start, mid, end;
+	int turn, i;
+
+	/* A long list that has thinned out, of monsters at normal speed */
+	fill_level(25);
+	for (i = 1; i < SCHED_MONSTERS; i++) {
+		if (!shadow[i].r_idx) continue;
+		shadow[i].mspeed = cave_monster(cave, i)->mspeed = 110;
+		mon_sched_update(cave, cave_monster(cave, i));
+	}
+
+	start = clock();
+	for (turn = 0; turn < BENCH_TURNS; turn++) {
+		pass_new(150);
+		pass_new(100);
+		mon_sched_tick(cave);
+	}
+	mid = clock();
+	for (turn = 0; turn < BENCH_TURNS; turn++) {
+		pass_old(150);
+		pass_old(100);
+		tick_old();
+	}
+	end = clock();
+
+	if (verbose)
+		printf("    %d turns: %.3fs scheduled, %.3fs scanned\n", BENCH_TURNS,
+		       (double)(mid - start) / CLOCKS_PER_SEC,
+		       (double)(end - mid) / CLOCKS_PER_SEC);
+
+	ok;
+}
+
+const char *suite_name = "monster/sched";
+struct test tests[] = {
+	{ "order", test_order },
+	{ "bench", test_bench },
+	{ NULL, NULL },
+};
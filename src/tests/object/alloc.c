@@ -0,0 +1,139 @@
+/* object/alloc
+ *
+ * Checks that get_obj_num() picks kinds with the same odds as the original
+ * linear scan of the allocation table
+ */
+
+#include "unit-test.h"
+#include "test-utils.h"
+#include "angband.h"
+#include "object/object.h"
+
+#include <math.h>
+#include <time.h>
+
+#define ALLOC_DRAWS	100000
+#define BENCH_DRAWS	100000
+
+/* Don't worry about probabilities for anything past dlev100 */
+#define MAX_O_DEPTH	100
+
+static u32b *count_new, *count_old;
+static byte *weight;
+static u32b total[MAX_O_DEPTH + 1];
+
+int setup_tests(void **state) {
+	int k_max, item, lev;
+
+	read_edit_files();
+	k_max = z_info->k_max;
+
+	/* The normal table as init_obj_alloc() makes it */
+	weight = mem_zalloc((MAX_O_DEPTH + 1) * k_max);
+	for (item = 1; item < k_max; item++) {
+		const object_kind *kind = &k_info[item];
+
+		for (lev = 0; lev <= MAX_O_DEPTH; lev++) {
+			if (lev < kind->alloc_min || lev > kind->alloc_max) continue;
+			weight[lev * k_max + item] = kind->alloc_prob;
+			total[lev] += kind->alloc_prob;
+		}
+	}
+
+	count_new = mem_zalloc(k_max * sizeof(*count_new));
+	count_old = mem_zalloc(k_max * sizeof(*count_old));
+
+	Rand_quick = FALSE;
+	Rand_state_init(4321);
+	return 0;
+}
+
+int teardown_tests(void *state) {
+	mem_free(weight);
+	mem_free(count_new);
+	mem_free(count_old);
+	return 0;
+}
+
+/* The original get_obj_num() for normal objects */
+static int old_get_obj_num(int level) {
+	size_t ind, item;
+	u32b value;
+
+	if ((level > 0) && one_in_(20))
+		level = 1 + (level * MAX_O_DEPTH / randint1(MAX_O_DEPTH));
+	level = MIN(level, MAX_O_DEPTH);
+	level = MAX(level, 0);
+
+	ind = level * z_info->k_max;
+	value = randint0(total[level]);
+	for (item = 1; item < z_info->k_max; item++) {
+		if (value < weight[ind + item]) break;
+		value -= weight[ind + item];
+	}
+
+	return item;
+}
+
+/* Two-sample chi-squared between the old and new pickers at one depth,
+ * with a bound about five standard deviations above the mean */
+static bool same_odds(int level) {
+	double chi = 0.0, bound;
+	int i, bins = 0;
+
+	memset(count_new, 0, z_info->k_max * sizeof(*count_new));
+	memset(count_old, 0, z_info->k_max * sizeof(*count_old));
+
+	for (i = 0; i < ALLOC_DRAWS; i++) {
+		count_new[get_obj_num(level, FALSE)->kidx]++;
+		count_old[old_get_obj_num(level)]++;
+	}
+
+	for (i = 0; i < z_info->k_max; i++) {
+		double a = count_new[i], b = count_old[i];
+
+		if (a + b == 0) continue;
+		chi += (a - b) * (a - b) / (a + b);
+		bins++;
+	}
+
+	bound = (bins - 1) + 5 * sqrt(2.0 * (bins - 1));
+	if (verbose)
+		printf("    depth %2d: chi-squared %.1f over %d kinds (bound %.1f)\n",
+		       level, chi, bins, bound);
+	return chi < bound;
+}
+
+int test_odds(void *state) {
+	require(same_odds(0));
+	require(same_odds(5));
+	require(same_odds(40));
+	require(same_odds(100));
+	ok;
+}
+
+int test_bench(void *state) {
+	clock_t start, mid, end;
+	int i;
+
+	start = clock();
+	for (i = 0; i < BENCH_DRAWS; i++)
+		old_get_obj_num(40);
+	mid = clock();
+	for (i = 0; i < BENCH_DRAWS; i++)
+		get_obj_num(40, FALSE);
+	end = clock();
+
+	if (verbose)
+		printf("    %d picks: %.3fs scan, %.3fs alias\n", BENCH_DRAWS,
+		       (double)(mid - start) / CLOCKS_PER_SEC,
+		       (double)(end - mid) / CLOCKS_PER_SEC);
+	ok;
+}
+
+const char *suite_name = "object/alloc";
+struct test tests[] = {
+	{ "odds", test_odds },
+	{ "bench", test_bench },
+	{ NULL, NULL }
+};
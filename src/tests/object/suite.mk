@@ -1 +1 @@
-TESTPROGS += object/attack object/util
+TESTPROGS += object/alloc object/attack object/util
@@ -47,8 +47,36 @@ int test_obj_can_refill(void *state) {
     ok;
 }
 
+int test_flags_known(void *state) {
+    struct object obj;
+    bitflag f[OF_SIZE];
+
+    object_prep(&obj, &test_lantern, 1, AVERAGE);
+    of_on(obj.flags, OF_SEE_INVIS);
+    object_flags_forget(&obj);
+
+    /* Not known, even when asked twice */
+    object_flags_known(&obj, f);
+    eq(of_has(f, OF_SEE_INVIS), FALSE);
+    object_flags_known(&obj, f);
+    eq(of_has(f, OF_SEE_INVIS), FALSE);
+
+    /* Learning about the object is not hidden by the cache */
+    object_know_all_flags(&obj);
+    object_flags_known(&obj, f);
+    eq(of_has(f, OF_SEE_INVIS), TRUE);
+
+    /* Nor is losing the flag */
+    of_off(obj.flags, OF_SEE_INVIS);
+    object_flags_forget(&obj);
+    object_flags_known(&obj, f);
+    eq(of_has(f, OF_SEE_INVIS), FALSE);
+    ok;
+}
+
 const char *suite_name = "object/util";
 struct test tests[] = {
     { "obj_can_refill", test_obj_can_refill },
+    { "flags_known", test_flags_known },
     { NULL, NULL }
 };
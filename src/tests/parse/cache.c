@@ -0,0 +1,239 @@
+/* parse/cache
+ *
+ * Checks that a compiled edit file gives the hooks exactly what the text
+ * did, and that changed text or directives send parse_file() back to the
+ * text
+ */
+
+#include "unit-test.h"
+
+#include "config.h"
+#include "externs.h"
+#include "init.h"
+#include "types.h"
+#include "z-file.h"
+#include "z-form.h"
+#include "z-util.h"
+#include "z-virt.h"
+
+#include <time.h>
+
+#define CACHE_DIR	"parse-cache.tmp"
+#define BENCH_RUNS	20
+
+/* What the hooks were given, one line per call */
+static char seen[4096];
+
+/* The real edit directory, for the benchmark */
+static char *edit_dir;
+
+static enum parser_error parse_n(struct parser *p) {
+	if (parser_getint(p, "idx") < 0)
+		return PARSE_ERROR_OUT_OF_BOUNDS;
+
+	my_strcat(seen, format("N %d %s\n", parser_getint(p, "idx"),
+		parser_getstr(p, "name")), sizeof(seen));
+	return PARSE_ERROR_NONE;
+}
+
+static enum parser_error parse_d(struct parser *p) {
+	my_strcat(seen, format("D %s", parser_getsym(p, "kind")), sizeof(seen));
+	if (parser_hasval(p, "dam")) {
+		random_value v = parser_getrand(p, "dam");
+
+		my_strcat(seen, format(" %d+%dd%dM%d", v.base, v.dice, v.sides,
+			v.m_bonus), sizeof(seen));
+	}
+	my_strcat(seen, "\n", sizeof(seen));
+	return PARSE_ERROR_NONE;
+}
+
+static enum parser_error parse_g(struct parser *p) {
+	my_strcat(seen, format("G %d %u\n", (int)parser_getchar(p, "glyph"),
+		parser_getuint(p, "count")), sizeof(seen));
+	return PARSE_ERROR_NONE;
+}
+
+static struct parser *test_parser(void) {
+	struct parser *p = parser_new();
+
+	parser_reg(p, "N int idx str name", parse_n);
+	parser_reg(p, "D sym kind ?rand dam", parse_d);
+	parser_reg(p, "G char glyph uint count", parse_g);
+	return p;
+}
+
+static void write_text(const char *text) {
+	char path[1024];
+	ang_file *fh;
+
+	path_build(path, sizeof(path), CACHE_DIR, "test.txt");
+	fh = file_open(path, MODE_WRITE, FTYPE_TEXT);
+	file_write(fh, text, strlen(text));
+	file_close(fh);
+}
+
+/* Parse test.txt, returning the error and whether the cache was used */
+static errr parse_test(struct parser *p, bool *cached) {
+	errr r;
+
+	seen[0] = '\0';
+	r = parse_file(p, "test");
+	*cached = parser_cached(p);
+	parser_destroy(p);
+	return r;
+}
+
+static const char *text =
+	"# A comment\n"
+	"N:1:first thing\n"
+	"D:fire:-2+3d4M5\n"
+	"D:cold\n"
+	"\n"
+	"N:2:second\tthing\r\n"
+	"G:#:7\n";
+
+int setup_tests(void **state) {
+	char configpath[512], libpath[512], datapath[512];
+
+	my_strcpy(configpath, DEFAULT_CONFIG_PATH, sizeof(configpath));
+	my_strcpy(libpath, DEFAULT_LIB_PATH, sizeof(libpath));
+	my_strcpy(datapath, DEFAULT_DATA_PATH, sizeof(datapath));
+	if (!suffix(configpath, PATH_SEP))
+		my_strcat(configpath, PATH_SEP, sizeof(configpath));
+	if (!suffix(libpath, PATH_SEP))
+		my_strcat(libpath, PATH_SEP, sizeof(libpath));
+	if (!suffix(datapath, PATH_SEP))
+		my_strcat(datapath, PATH_SEP, sizeof(datapath));
+	init_file_paths(configpath, libpath, datapath);
+
+	/* Keep both the edit files and their compiled copies out of the way */
+	edit_dir = ANGBAND_DIR_EDIT;
+	ANGBAND_DIR_EDIT = string_make(CACHE_DIR);
+	string_free(ANGBAND_DIR_USER);
+	ANGBAND_DIR_USER = string_make(CACHE_DIR);
+	return !dir_create(CACHE_DIR);
+}
+
+int teardown_tests(void *state) {
+	char path[1024];
+
+	path_build(path, sizeof(path), CACHE_DIR, "data" PATH_SEP "test.raw");
+	file_delete(path);
+	path_build(path, sizeof(path), CACHE_DIR, "data" PATH_SEP "vault.raw");
+	file_delete(path);
+	path_build(path, sizeof(path), CACHE_DIR, "test.txt");
+	file_delete(path);
+	path_build(path, sizeof(path), CACHE_DIR, "data");
+	remove(path);
+	remove(CACHE_DIR);
+
+	string_free(ANGBAND_DIR_EDIT);
+	ANGBAND_DIR_EDIT = edit_dir;
+	return 0;
+}
+
+int test_replay(void *state) {
+	char first[sizeof(seen)];
+	bool cached;
+
+	write_text(text);
+	eq(parse_test(test_parser(), &cached), 0);
+	require(!cached);
+	require(streq(seen, "N 1 first thing\n"
+		"D fire -22+3d4M5\n"
+		"D cold\n"
+		"N 2 second  thing\n"
+		"G 35 7\n"));
+	my_strcpy(first, seen, sizeof(first));
+
+	eq(parse_test(test_parser(), &cached), 0);
+	require(cached);
+	require(streq(seen, first));
+	ok;
+}
+
+int test_stale(void *state) {
+	struct parser *p;
+	bool cached;
+
+	/* Changed text */
+	write_text(format("%sN:3:third\n", text));
+	eq(parse_test(test_parser(), &cached), 0);
+	require(!cached);
+	require(suffix(seen, "N 3 third\n"));
+	eq(parse_test(test_parser(), &cached), 0);
+	require(cached);
+
+	/* Changed directives */
+	p = test_parser();
+	parser_reg(p, "X int extra", ignored);
+	eq(parse_test(p, &cached), 0);
+	require(!cached);
+	ok;
+}
+
+int test_error(void *state) {
+	struct parser *p = test_parser();
+	struct parser_state s;
+	bool cached;
+
+	/* Lines that fail are reported, and the file is not compiled */
+	write_text("N:1:fine\nN:-1:bad\n");
+	eq(parse_file(p, "test"), PARSE_ERROR_OUT_OF_BOUNDS);
+	parser_getstate(p, &s);
+	eq(s.line, 2);
+	parser_destroy(p);
+
+	eq(parse_test(test_parser(), &cached), PARSE_ERROR_OUT_OF_BOUNDS);
+	require(!cached);
+	ok;
+}
+
+/* Microbenchmark: BENCH_RUNS parses of vault.txt, from the text (which
+ * also compiles it) and from the compiled copy */
+int test_bench(void *state) {
+	clock_t start, mid, end;
+	char *dir = ANGBAND_DIR_EDIT;
+	char path[1024];
+	struct parser *p;
+	int i;
+
+	path_build(path, sizeof(path), CACHE_DIR, "data" PATH_SEP "vault.raw");
+	ANGBAND_DIR_EDIT = edit_dir;
+
+	start = clock();
+	for (i = 0; i < BENCH_RUNS; i++) {
+		file_delete(path);
+		p = init_parse_v();
+		eq(parse_file(p, "vault"), 0);
+		require(!parser_cached(p));
+		parser_destroy(p);
+	}
+	mid = clock();
+	for (i = 0; i < BENCH_RUNS; i++) {
+		p = init_parse_v();
+		eq(parse_file(p, "vault"), 0);
+		require(parser_cached(p));
+		parser_destroy(p);
+	}
+	end = clock();
+
+	ANGBAND_DIR_EDIT = dir;
+
+	if (verbose)
+		printf("    %d parses: %.3fs text, %.3fs compiled\n", BENCH_RUNS,
+		       (double)(mid - start) / CLOCKS_PER_SEC,
+		       (double)(end - mid) / CLOCKS_PER_SEC);
+
+	ok;
+}
+
+const char *suite_name = "parse/cache";
+struct test tests[] = {
+	{ "replay", test_replay },
+	{ "stale", test_stale },
+	{ "error", test_error },
+	{ "bench", test_bench },
+	{ NULL, NULL },
+};
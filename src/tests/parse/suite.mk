@@ -1,4 +1,5 @@
 TESTPROGS += parse/a-info \
+             parse/cache \
              parse/c-info \
              parse/e-info \
 	     parse/f-info \
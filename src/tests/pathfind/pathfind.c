@@ -1,11 +1,180 @@
 /* pathfind/pathfind */
 
 #include "unit-test.h"
+#include "angband.h"
+#include "cave.h"
 #include "game-cmd.h"
 #include "pathfind.h"
 
-NOSETUP
-NOTEARDOWN
+#include <time.h>
+
+#define PATH_MAX_STEPS	(DUNGEON_HGT * DUNGEON_WID)
+#define BENCH_PATHS	200
+
+static char path[PATH_MAX_STEPS];
+
+int setup_tests(void **state) {
+	cave = mem_zalloc(sizeof *cave);
+	cave->info = C_ZNEW(DUNGEON_HGT, byte_256);
+	return 0;
+}
+
+int teardown_tests(void *state) {
+	mem_free(cave->info);
+	mem_free(cave);
+	cave = NULL;
+	return 0;
+}
+
+/* An unexplored level: every grid counts as open */
+static void open_level(void) {
+	int y;
+
+	for (y = 0; y < DUNGEON_HGT; y++)
+		memset(cave->info[y], 0, sizeof(byte_256));
+}
+
+/* A fully known serpentine maze, with a wall across every other row and
+ * the gaps at alternate ends */
+static void maze_level(void) {
+	int y, x;
+
+	for (y = 0; y < DUNGEON_HGT; y++) {
+		for (x = 0; x < DUNGEON_WID; x++) {
+			bool wall = (y % 2 == 0) && !(y % 4 == 0 && x == DUNGEON_WID - 2) &&
+				!(y % 4 == 2 && x == 1);
+			cave->info[y][x] = CAVE_MARK | (wall ? CAVE_WALL : 0);
+		}
+	}
+}
+
+/* Breadth-first reference distance, or -1 if unreachable */
+static int bfs_distance(struct loc from, struct loc to) {
+	static int dist[DUNGEON_HGT][DUNGEON_WID];
+	static struct loc queue[DUNGEON_HGT * DUNGEON_WID];
+	int head = 0, tail = 0, y, x, dir;
+
+	for (y = 0; y < DUNGEON_HGT; y++)
+		for (x = 0; x < DUNGEON_WID; x++)
+			dist[y][x] = -1;
+
+	dist[from.y][from.x] = 0;
+	queue[tail++] = from;
+
+	while (head < tail) {
+		struct loc g = queue[head++];
+
+		if (g.x == to.x && g.y == to.y) break;
+
+		for (dir = 1; dir < 10; dir++) {
+			int ny = g.y + ddy[dir], nx = g.x + ddx[dir];
+
+			if (dir == 5 || !in_bounds_fully(ny, nx)) continue;
+			if (dist[ny][nx] >= 0) continue;
+			if (cave->info[ny][nx] & CAVE_WALL) continue;
+
+			dist[ny][nx] = dist[g.y][g.x] + 1;
+			queue[tail++] = loc(nx, ny);
+		}
+	}
+
+	return dist[to.y][to.x];
+}
+
+/* Follow the steps in path (last step first) and check they end at to
+ * without crossing a wall */
+static bool walk_path(struct loc from, struct loc to, int n) {
+	int x = from.x, y = from.y;
+
+	while (n--) {
+		int dir = path[n] - '0';
+
+		if (dir < 1 || dir > 9 || dir == 5) return FALSE;
+		x += ddx[dir];
+		y += ddy[dir];
+		if (cave->info[y][x] & CAVE_WALL) return FALSE;
+	}
+
+	return x == to.x && y == to.y;
+}
+
+int test_open(void *state) {
+	struct loc from = loc(1, 1);
+	struct loc to = loc(DUNGEON_WID - 2, 20);
+	int n;
+
+	open_level();
+	n = pathfind_path(from, to, path, PATH_MAX_STEPS);
+	eq(n, DUNGEON_WID - 3);
+	require(walk_path(from, to, n));
+
+	/* Not enough steps allowed */
+	eq(pathfind_path(from, to, path, n - 1), -1);
+
+	/* Off the map */
+	eq(pathfind_path(from, loc(0, 5), path, PATH_MAX_STEPS), -1);
+
+	/* Nowhere to go */
+	eq(pathfind_path(from, from, path, PATH_MAX_STEPS), 0);
+	ok;
+}
+
+int test_maze(void *state) {
+	struct loc from = loc(1, 1);
+	struct loc to = loc(DUNGEON_WID / 2, DUNGEON_HGT - 3);
+	int n;
+
+	maze_level();
+	n = pathfind_path(from, to, path, PATH_MAX_STEPS);
+	require(n > 0);
+	eq(n, bfs_distance(from, to));
+	require(walk_path(from, to, n));
+	ok;
+}
+
+int test_blocked(void *state) {
+	struct loc to = loc(50, 30);
+	int dir, n;
+
+	open_level();
+	for (dir = 1; dir < 10; dir++)
+		if (dir != 5)
+			cave->info[to.y + ddy[dir]][to.x + ddx[dir]] = CAVE_MARK | CAVE_WALL;
+
+	eq(pathfind_path(loc(1, 1), to, path, PATH_MAX_STEPS), -1);
+
+	/* A known wall may still be the goal */
+	to = loc(51, 30);
+	n = pathfind_path(loc(60, 30), to, path, PATH_MAX_STEPS);
+	eq(n, 9);
+	ok;
+}
+
+/* Microbenchmark: BENCH_PATHS long searches on each kind of level */
+int test_bench(void *state) {
+	clock_t start, mid, end;
+	int i;
+
+	open_level();
+	start = clock();
+	for (i = 0; i < BENCH_PATHS; i++)
+		require(pathfind_path(loc(1, 1 + i % 60), loc(DUNGEON_WID - 2, 60 - i % 60),
+			path, PATH_MAX_STEPS) > 0);
+	mid = clock();
+
+	maze_level();
+	for (i = 0; i < BENCH_PATHS; i++)
+		require(pathfind_path(loc(1 + i % 100, 1), loc(DUNGEON_WID - 2 - i % 100,
+			DUNGEON_HGT - 3), path, PATH_MAX_STEPS) > 0);
+	end = clock();
+
+	if (verbose)
+		printf("    %d paths: %.3fs open, %.3fs maze\n", BENCH_PATHS,
+		       (double)(mid - start) / CLOCKS_PER_SEC,
+		       (double)(end - mid) / CLOCKS_PER_SEC);
+
+	ok;
+}
 
 int test_dir_to(void *state) {
 	eq(pathfind_direction_to(loc(0,0), loc(0,1)), DIR_N);
@@ -27,5 +196,9 @@ int test_dir_to(void *state) {
 const char *suite_name = "pathfind/pathfind";
 struct test tests[] = {
 	{ "dir-to", test_dir_to },
+	{ "open", test_open },
+	{ "maze", test_maze },
+	{ "blocked", test_blocked },
+	{ "bench", test_bench },
 	{ NULL, NULL },
 };
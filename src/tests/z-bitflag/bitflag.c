@@ -0,0 +1,172 @@
+/* z-bitflag/bitflag
+ *
+ * Checks the word-at-a-time bitfield operations against simple byte loops,
+ * over sizes and alignments that leave bytes over at either end
+ */
+
+#include "unit-test.h"
+#include "z-bitflag.h"
+#include "z-rand.h"
+
+#include <time.h>
+
+#define MAX_SIZE	40
+#define CHECK_ROUNDS	2000
+#define BENCH_SIZE	12
+#define BENCH_ROUNDS	2000000
+
+/* Room for a bitfield at any alignment */
+static bitflag buf1[MAX_SIZE + 8], buf2[MAX_SIZE + 8], ref[MAX_SIZE + 8];
+
+int setup_tests(void **state) {
+	Rand_quick = FALSE;
+	Rand_state_init(99);
+	return 0;
+}
+
+int teardown_tests(void *state) {
+	return 0;
+}
+
+/* Sparse, dense, empty or full bytes, so every branch gets exercised */
+static void random_flags(bitflag *flags, size_t size) {
+	size_t i;
+	int kind = randint0(4);
+
+	for (i = 0; i < size; i++) {
+		if (kind == 0) flags[i] = one_in_(8) ? (1 << randint0(8)) : 0;
+		else if (kind == 1) flags[i] = randint0(256);
+		else if (kind == 2) flags[i] = one_in_(size * 2) ? randint0(256) : 0;
+		else flags[i] = one_in_(size * 2) ? randint0(256) : 255;
+	}
+}
+
+int test_predicates(void *state) {
+	int round;
+
+	for (round = 0; round < CHECK_ROUNDS; round++) {
+		size_t size = randint1(MAX_SIZE), i;
+		bitflag *f1 = buf1 + randint0(8), *f2 = buf2 + randint0(8);
+		bool empty = TRUE, full = TRUE, inter = FALSE, subset = TRUE;
+
+		random_flags(f1, size);
+		random_flags(f2, size);
+
+		for (i = 0; i < size; i++) {
+			if (f1[i]) empty = FALSE;
+			if (f1[i] != 255) full = FALSE;
+			if (f1[i] & f2[i]) inter = TRUE;
+			if (~f1[i] & f2[i]) subset = FALSE;
+		}
+
+		eq(flag_is_empty(f1, size), empty);
+		eq(flag_is_full(f1, size), full);
+		eq(flag_is_inter(f1, f2, size), inter);
+		eq(flag_is_subset(f1, f2, size), subset);
+	}
+
+	ok;
+}
+
+int test_operations(void *state) {
+	int round;
+
+	for (round = 0; round < CHECK_ROUNDS; round++) {
+		size_t size = randint1(MAX_SIZE), i;
+		bitflag *f1 = buf1 + randint0(8), *f2 = buf2 + randint0(8);
+		int op = randint0(4);
+		bool delta = FALSE, changed;
+
+		random_flags(f1, size);
+		random_flags(f2, size);
+		memcpy(ref, f1, size);
+
+		for (i = 0; i < size; i++) {
+			if (op == 0) {
+				if (~ref[i] & f2[i]) delta = TRUE;
+				ref[i] |= f2[i];
+			} else if (op == 1) {
+				if (ref[i] != f2[i]) delta = TRUE;
+				ref[i] &= f2[i];
+			} else if (op == 2) {
+				if (ref[i] & f2[i]) delta = TRUE;
+				ref[i] &= ~f2[i];
+			} else {
+				ref[i] = ~ref[i];
+			}
+		}
+
+		if (op == 0) changed = flag_union(f1, f2, size);
+		else if (op == 1) changed = flag_inter(f1, f2, size);
+		else if (op == 2) changed = flag_diff(f1, f2, size);
+		else changed = delta, flag_negate(f1, size);
+
+		eq(changed, delta);
+		require(!memcmp(f1, ref, size));
+	}
+
+	ok;
+}
+
+int test_next(void *state) {
+	int round;
+
+	for (round = 0; round < CHECK_ROUNDS; round++) {
+		size_t size = randint1(MAX_SIZE);
+		bitflag *f1 = buf1 + randint0(8);
+		int f, g = FLAG_START;
+
+		random_flags(f1, size);
+
+		for (f = flag_next(f1, size, FLAG_START); f != FLAG_END;
+				f = flag_next(f1, size, f + 1)) {
+			/* Nothing skipped on the way */
+			for (; g < f; g++)
+				require(!flag_has(f1, size, g));
+			require(flag_has(f1, size, f));
+			g = f + 1;
+		}
+
+		for (; g < FLAG_MAX(size); g++)
+			require(!flag_has(f1, size, g));
+	}
+
+	ok;
+}
+
+/* Microbenchmark: the operations behind object and monster flag checks */
+int test_bench(void *state) {
+	clock_t start, end;
+	int round, f, found = 0;
+
+	random_flags(buf1, BENCH_SIZE);
+	random_flags(buf2, BENCH_SIZE);
+
+	start = clock();
+	for (round = 0; round < BENCH_ROUNDS; round++) {
+		flag_union(ref, buf1, BENCH_SIZE);
+		flag_inter(ref, buf2, BENCH_SIZE);
+		found += flag_is_inter(ref, buf2, BENCH_SIZE);
+		found += flag_is_subset(ref, buf1, BENCH_SIZE);
+		for (f = flag_next(ref, BENCH_SIZE, FLAG_START); f != FLAG_END;
+				f = flag_next(ref, BENCH_SIZE, f + 1))
+			found++;
+		flag_wipe(ref, BENCH_SIZE);
+	}
+	end = clock();
+
+	if (verbose)
+		printf("    %d rounds: %.3fs (%d)\n", BENCH_ROUNDS,
+		       (double)(end - start) / CLOCKS_PER_SEC, found);
+
+	ok;
+}
+
+const char *suite_name = "z-bitflag/bitflag";
+struct test tests[] = {
+	{ "predicates", test_predicates },
+	{ "operations", test_operations },
+	{ "next", test_next },
+	{ "bench", test_bench },
+	{ NULL, NULL },
+};
@@ -0,0 +1,68 @@
+/* z-msg/msg.c */
+
+#include "unit-test.h"
+#include "z-form.h"
+#include "z-msg.h"
+
+int setup_tests(void **state) {
+	messages_init();
+	return 0;
+}
+
+int teardown_tests(void *state) {
+	messages_free();
+	return 0;
+}
+
+int test_empty(void *state) {
+	eq(messages_num(), 0);
+	require(!strcmp(message_str(0), ""));
+	eq(message_count(0), 0);
+	ok;
+}
+
+int test_add(void *state) {
+	message_add("The orc sets your hair on fire.", MSG_GENERIC);
+	message_add("The orc sets your hair on fire.", MSG_GENERIC);
+	message_add("You feel better.", MSG_RECOVER);
+
+	eq(messages_num(), 2);
+	require(!strcmp(message_str(0), "You feel better."));
+	eq(message_type(0), MSG_RECOVER);
+	eq(message_count(0), 1);
+	require(!strcmp(message_str(1), "The orc sets your hair on fire."));
+	eq(message_count(1), 2);
+	require(!strcmp(message_str(2), ""));
+	ok;
+}
+
+int test_wrap(void *state) {
+	char buf[32];
+	int i;
+
+	/* Well past the 2048 message limit */
+	for (i = 0; i < 5000; i++) {
+		strnfmt(buf, sizeof(buf), "message %d", i);
+		message_add(buf, MSG_GENERIC);
+	}
+
+	eq(messages_num(), 2048);
+	require(!strcmp(message_str(0), "message 4999"));
+	require(!strcmp(message_str(2047), "message 2952"));
+	require(!strcmp(message_str(2048), ""));
+
+	/* Longer text reuses a slot which held a short message */
+	message_add("A much longer message than any of the numbered ones above, "
+		"which needs more room than the slot's old text.", MSG_GENERIC);
+	require(!strcmp(message_str(1), "message 4999"));
+	eq(message_count(0), 1);
+	ok;
+}
+
+const char *suite_name = "z-msg/msg";
+struct test tests[] = {
+	{ "empty", test_empty },
+	{ "add", test_add },
+	{ "wrap", test_wrap },
+	{ NULL, NULL }
+};
@@ -2,6 +2,12 @@
 
 #include "unit-test.h"
 #include "z-quark.h"
+#include "z-form.h"
+#include "z-virt.h"
+
+#include <time.h>
+
+#define BENCH_QUARKS 100000
 
 int setup_tests(void **state) {
 	quarks_init();
@@ -46,9 +52,86 @@ int test_dedup(void *state) {
 	ok;
 }
 
+int test_long(void *state) {
+	/* Longer than an arena block */
+	size_t len = 20000;
+	char *buf = mem_zalloc(len + 1);
+	quark_t q1, q2;
+
+	memset(buf, 'x', len);
+	q1 = quark_add(buf);
+	q2 = quark_add("2-short");
+
+	require(strlen(quark_str(q1)) == len);
+	require(!strcmp(quark_str(q2), "2-short"));
+	require(quark_add(buf) == q1);
+
+	mem_free(buf);
+	ok;
+}
+
+int test_many(void *state) {
+	char buf[32];
+	quark_t first = 0;
+	int i;
+
+	/* Enough to regrow the index and span several arena blocks */
+	for (i = 0; i < 5000; i++) {
+		quark_t q;
+
+		strnfmt(buf, sizeof(buf), "3-%d", i);
+		q = quark_add(buf);
+		if (i == 0) first = q;
+		eq(q, first + i);
+	}
+
+	for (i = 0; i < 5000; i++) {
+		strnfmt(buf, sizeof(buf), "3-%d", i);
+		eq(quark_add(buf), first + i);
+		require(!strcmp(quark_str(first + i), buf));
+	}
+
+	require(quark_str(first + 5000) == NULL);
+
+	ok;
+}
+
+/* Microbenchmark: intern BENCH_QUARKS new strings, then look them all up again */
+int test_bench(void *state) {
+	char buf[32];
+	quark_t first = 0;
+	clock_t start, mid, end;
+	int i;
+
+	start = clock();
+	for (i = 0; i < BENCH_QUARKS; i++) {
+		strnfmt(buf, sizeof(buf), "4-inscription-%d", i);
+		if (i == 0)
+			first = quark_add(buf);
+		else
+			quark_add(buf);
+	}
+	mid = clock();
+	for (i = 0; i < BENCH_QUARKS; i++) {
+		strnfmt(buf, sizeof(buf), "4-inscription-%d", i);
+		eq(quark_add(buf), first + i);
+	}
+	end = clock();
+
+	if (verbose)
+		printf("    %d quarks: %.3fs to add, %.3fs to find\n", BENCH_QUARKS,
+		       (double)(mid - start) / CLOCKS_PER_SEC,
+		       (double)(end - mid) / CLOCKS_PER_SEC);
+
+	ok;
+}
+
 const char *suite_name = "z-quark/quark";
 struct test tests[] = {
 	{ "alloc", test_alloc },
 	{ "dedup", test_dedup },
+	{ "long", test_long },
+	{ "many", test_many },
+	{ "bench", test_bench },
 	{ NULL, NULL }
 };
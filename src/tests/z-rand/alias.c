@@ -0,0 +1,142 @@
+/* z-rand/alias */
+
+#include "unit-test.h"
+#include "z-rand.h"
+#include "z-virt.h"
+
+#include <math.h>
+
+#define ALIAS_SIZE	500
+#define ALIAS_DRAWS	500000
+
+static struct alias_table table;
+static u32b weight[ALIAS_SIZE];
+
+int setup_tests(void **state) {
+	Rand_quick = FALSE;
+	Rand_state_init(42);
+	return 0;
+}
+
+int teardown_tests(void *state) {
+	Rand_alias_free(&table);
+	return 0;
+}
+
+static void build(int size) {
+	int i;
+
+	Rand_alias_init(&table, size);
+	for (i = 0; i < size; i++)
+		table.prob[i] = weight[i];
+	Rand_alias_build(&table);
+}
+
+/* Check that the units each entry gets across all the columns are exactly
+ * its weight scaled by the table size */
+static bool exact(int size) {
+	u32b total = 0;
+	u32b *mass = mem_zalloc(size * sizeof(*mass));
+	bool good = TRUE;
+	int i;
+
+	for (i = 0; i < size; i++) {
+		total += weight[i];
+		if (table.prob[i] > table.total) good = FALSE;
+		mass[i] += table.prob[i];
+		mass[table.alias[i]] += table.total - table.prob[i];
+	}
+
+	if (table.total != total) good = FALSE;
+	for (i = 0; i < size; i++)
+		if (mass[i] != weight[i] * size) good = FALSE;
+
+	mem_free(mass);
+	return good;
+}
+
+int test_exact(void *state) {
+	int i, pass;
+
+	/* Equal weights */
+	for (i = 0; i < ALIAS_SIZE; i++) weight[i] = 7;
+	build(ALIAS_SIZE);
+	require(exact(ALIAS_SIZE));
+
+	/* A single possibility */
+	memset(weight, 0, sizeof(weight));
+	weight[ALIAS_SIZE / 2] = 3;
+	build(ALIAS_SIZE);
+	require(exact(ALIAS_SIZE));
+	for (i = 0; i < 100; i++)
+		eq(Rand_alias(&table), ALIAS_SIZE / 2);
+
+	/* Random weights like the allocation tables', many of them zero */
+	for (pass = 0; pass < 20; pass++) {
+		int size = 1 + randint0(ALIAS_SIZE);
+
+		for (i = 0; i < size; i++)
+			weight[i] = one_in_(3) ? 0 : randint0(256);
+		build(size);
+		require(exact(size));
+	}
+
+	ok;
+}
+
+int test_empty(void *state) {
+	memset(weight, 0, sizeof(weight));
+	build(ALIAS_SIZE);
+	eq(Rand_alias(&table), -1);
+
+	build(0);
+	eq(Rand_alias(&table), -1);
+	ok;
+}
+
+/* Draws should follow the weights: Pearson's chi-squared, with a bound
+ * well past anything a correct table produces */
+int test_sample(void *state) {
+	static u32b count[ALIAS_SIZE];
+	double chi = 0.0, bound;
+	u32b total = 0;
+	int i, bins = 0;
+
+	for (i = 0; i < ALIAS_SIZE; i++) {
+		weight[i] = (i % 5) ? 1 + i % 97 : 0;
+		total += weight[i];
+	}
+	build(ALIAS_SIZE);
+
+	memset(count, 0, sizeof(count));
+	for (i = 0; i < ALIAS_DRAWS; i++)
+		count[Rand_alias(&table)]++;
+
+	for (i = 0; i < ALIAS_SIZE; i++) {
+		double expect = (double)ALIAS_DRAWS * weight[i] / total;
+
+		if (!weight[i]) {
+			eq(count[i], 0);
+			continue;
+		}
+
+		chi += (count[i] - expect) * (count[i] - expect) / expect;
+		bins++;
+	}
+
+	/* About five standard deviations above the mean of df */
+	bound = (bins - 1) + 5 * sqrt(2.0 * (bins - 1));
+	if (verbose)
+		printf("    chi-squared %.1f over %d bins (bound %.1f)\n", chi, bins,
+		       bound);
+	require(chi < bound);
+	ok;
+}
+
+const char *suite_name = "z-rand/alias";
+struct test tests[] = {
+	{ "exact", test_exact },
+	{ "empty", test_empty },
+	{ "sample", test_sample },
+	{ NULL, NULL }
+};
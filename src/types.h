@@ -25,6 +25,9 @@ typedef byte byte_wid[DUNGEON_WID];
 /** An array of DUNGEON_WID s16b's */
 typedef s16b s16b_wid[DUNGEON_WID];
 
+/** An array of DUNGEON_WID u32b's */
+typedef u32b u32b_wid[DUNGEON_WID];
+
 
 
 /** Function hook types **/
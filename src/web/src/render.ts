@@ -6,6 +6,7 @@ namespace angband {
     num: number,
     name: string,
     css: string,
+    url: string,
     width: number, // width and height of a single cell
     height: number,
     columns: number,
@@ -18,6 +19,7 @@ namespace angband {
       num: 1,
       name: "old",
       css: 'angband-sprites-1',
+      url: 'assets/graf/8x8.png',
       width: 8,
       height: 8,
       columns: 83,
@@ -27,6 +29,7 @@ namespace angband {
       num: 2,
       name: "new",
       css: 'angband-sprites-2',
+      url: 'assets/graf/16x16.png',
       width: 16,
       height: 16,
       columns: 32,
@@ -36,6 +39,7 @@ namespace angband {
       num: 3,
       name: "david",
       css: 'angband-sprites-3',
+      url: 'assets/graf/32x32.png',
       width: 32,
       height: 32,
       columns: 128,
@@ -45,6 +49,7 @@ namespace angband {
       num: 4,
       name: "nomad",
       css: 'angband-sprites-4',
+      url: 'assets/graf/8x16.png',
       width: 16,
       height: 16,
       columns: 32,
@@ -54,6 +59,7 @@ namespace angband {
       num: 5,
       name: "shock",
       css: 'angband-sprites-5',
+      url: 'assets/graf/64x64.png',
       width: 64,
       height: 64,
       columns: 128,
@@ -181,6 +187,14 @@ namespace angband {
 
   const CURSOR_CLASS = "angband-cursor";
 
+  // Cursor outline drawn by the canvas renderer, matching .angband-cursor.
+  const CURSOR_STROKE = "rgba(255, 229, 97, 0.75)";
+  const CURSOR_WIDTH = 1.5;
+
+  // Frame buffer cell layout, copied from main-emscripten.c.
+  const FRAME_CELL_WORDS = 6;
+  const FRAME_CELL_PICT = 1;
+
   interface SpriteLoc {
     row: number;
     col: number;
@@ -193,6 +207,15 @@ namespace angband {
     terrain: SpriteLoc | undefined;
   };
 
+  // \return whether two picts draw the same thing.
+  function samePict(a: Pict | undefined, b: Pict | undefined): boolean {
+    if (a === b) return true;
+    if (!a || !b) return false;
+    const sameLoc = (x: SpriteLoc | undefined, y: SpriteLoc | undefined) =>
+      x === y || (!!x && !!y && x.row === y.row && x.col === y.col);
+    return a.sprites === b.sprites && sameLoc(a.foreground, b.foreground) && sameLoc(a.terrain, b.terrain);
+  }
+
   // \return a background-position string for a pict.
   function spritePosition(sprites: SpriteSheet, loc: SpriteLoc): string {
     const xpos = loc.col / (sprites.columns - 1);
@@ -200,6 +223,15 @@ namespace angband {
     return `${xpos * 100}% ${ypos * 100}%`;
   }
 
+  // \return a string like #FF0000 for an RGB value.
+  function rgbString(rgb: number): string {
+    // Common case.
+    if (rgb === 0) return "#000000";
+    let rgbtext = rgb.toString(16);
+    while (rgbtext.length < 6) rgbtext = '0' + rgbtext;
+    return '#' + rgbtext;
+  }
+
   /* Helper to efficiently update CSS classes as sprite sheets change. */
   class SpriteClassUpdater {
     private lastDrawn: SpriteSheet | undefined = undefined;
@@ -215,22 +247,13 @@ namespace angband {
     }
   };
 
+  // What a cell should show. Painters turn this into pixels.
   class Cell {
     public text: string = "";
     public rgb: number = 0;
     public pict: Pict | undefined = undefined;
     public dirty: boolean = false;
     public cursor: boolean = false;
-    private lastDrawCursor: boolean = false;
-    private foregroundUpdater: SpriteClassUpdater;
-    private terrainUpdater: SpriteClassUpdater;
-
-    // A Cell has a div inside of a td table cell.
-    // The div draws on top of the td and is used for foreground pictures.
-    constructor(public element: HTMLDivElement, public datacell: HTMLTableDataCellElement) {
-      this.foregroundUpdater = new SpriteClassUpdater(element);
-      this.terrainUpdater = new SpriteClassUpdater(datacell);
-    }
 
     // Set our text and color, perhaps marking us dirty.
     // \return if we are dirty.
@@ -247,22 +270,13 @@ namespace angband {
     // Set a picture, or null.
     // \return if we are dirty.
     public setPict(pict: Pict | undefined) {
-      if (this.pict !== pict) {
+      if (!samePict(this.pict, pict)) {
         this.pict = pict;
         this.dirty = true;
       }
       return this.dirty;
     }
 
-    // \return a line like #FF0000 for our RGB.
-    rgbString(): string {
-      // Common case.
-      if (this.rgb === 0) return "#000000";
-      let rgbtext = this.rgb.toString(16);
-      while (rgbtext.length < 6) rgbtext = '0' + rgbtext;
-      return '#' + rgbtext;
-    }
-
     // Mark ourselves as having the cursor.
     // \return true if dirty.
     public setHasCursor(flag: boolean) {
@@ -272,75 +286,303 @@ namespace angband {
       }
       return this.dirty;
     }
+  }
 
+  type Column = Cell;
+  type Row = Column[];
 
-    public drawIfDirty() {
-      if (!this.dirty) return;
-      this.dirty = false;
-      if (this.pict) {
-        const sprites = this.pict.sprites;
+  // Draws cells onto the page. The Grid tells it which cells changed.
+  interface Painter {
+    // The element the painter draws into.
+    readonly element: HTMLElement;
+
+    // Set up for a grid of the given size; every cell is then painted.
+    rebuild(rows: number, columns: number): void;
+
+    // Draw one cell that has changed.
+    paintCell(row: number, col: number, cell: Cell): void;
+  }
+
+  // The DOM elements behind one cell of a DomPainter.
+  class DomCell {
+    private lastDrawCursor: boolean = false;
+    private foregroundUpdater: SpriteClassUpdater;
+    private terrainUpdater: SpriteClassUpdater;
+
+    // A Cell has a div inside of a td table cell.
+    // The div draws on top of the td and is used for foreground pictures.
+    constructor(public element: HTMLDivElement, public datacell: HTMLTableDataCellElement) {
+      this.foregroundUpdater = new SpriteClassUpdater(element);
+      this.terrainUpdater = new SpriteClassUpdater(datacell);
+    }
+
+    public draw(cell: Cell) {
+      if (cell.pict) {
+        const sprites = cell.pict.sprites;
         this.element.textContent = "";
-        this.element.style.backgroundPosition = spritePosition(sprites, this.pict.foreground);
-        if (this.pict.terrain) {
-          this.datacell.style.backgroundPosition = spritePosition(sprites, this.pict.terrain);
+        this.element.style.backgroundPosition = spritePosition(sprites, cell.pict.foreground);
+        if (cell.pict.terrain) {
+          this.datacell.style.backgroundPosition = spritePosition(sprites, cell.pict.terrain);
         }
         this.foregroundUpdater.setSprites(sprites);
-        this.terrainUpdater.setSprites(this.pict.terrain ? sprites : undefined);
+        this.terrainUpdater.setSprites(cell.pict.terrain ? sprites : undefined);
       } else {
-        this.element.style.color = this.rgbString();
-        this.element.textContent = this.text;
+        this.element.style.color = rgbString(cell.rgb);
+        this.element.textContent = cell.text;
         this.foregroundUpdater.setSprites(undefined);
         this.terrainUpdater.setSprites(undefined);
       }
 
-      if (this.cursor !== this.lastDrawCursor) {
+      if (cell.cursor !== this.lastDrawCursor) {
         let classes = this.element.classList;
-        this.cursor ? classes.add(CURSOR_CLASS) : classes.remove(CURSOR_CLASS);
-        this.lastDrawCursor = this.cursor;
+        cell.cursor ? classes.add(CURSOR_CLASS) : classes.remove(CURSOR_CLASS);
+        this.lastDrawCursor = cell.cursor;
       }
     }
   }
 
-  type Column = Cell;
-  type Row = Column[];
-
-  export class Grid {
-    public columns: number = 80;
-    public rows: number = 24;
-
-    cells: Row[] = [];
-    cursor: Cell | null = null;
-
-    displayRequest: number | undefined = undefined;
+  // Paints the grid as an HTML table, one td+div per cell, styled with CSS.
+  class DomPainter implements Painter {
+    cells: DomCell[][] = [];
 
     constructor(public element: HTMLTableElement) {
     }
 
     // Rebuild our table.
-    rebuildCells() {
+    rebuild(rows: number, columns: number) {
       while (this.element.firstChild) {
         this.element.removeChild(this.element.firstChild);
       }
-      this.cursor = null;
 
       this.cells.length = 0;
-      for (let row = 0; row < this.rows; row++) {
+      for (let row = 0; row < rows; row++) {
         var tr = document.createElement('tr');
         let rowlist = [];
-        for (let col = 0; col < this.columns; col++) {
+        for (let col = 0; col < columns; col++) {
           let td = document.createElement("td");
           tr.appendChild(td);
 
           let div = document.createElement("div");
           td.appendChild(div);
           div.textContent = "";
-          rowlist.push(new Cell(div, td));
+          rowlist.push(new DomCell(div, td));
         }
         this.cells.push(rowlist);
         this.element.appendChild(tr);
       }
     }
 
+    paintCell(row: number, col: number, cell: Cell) {
+      this.cells[row][col].draw(cell);
+    }
+  }
+
+  // Pre-rasterised glyphs, one slot per (character, colour) pair seen so far.
+  // Slots are cellWidth x cellHeight device pixels, packed in rows of ATLAS_COLUMNS.
+  const ATLAS_COLUMNS = 64;
+
+  class GlyphAtlas {
+    public canvas: HTMLCanvasElement;
+    private context: CanvasRenderingContext2D;
+    private slots: Map<number, number> = new Map();
+    private capacityRows: number = 0;
+
+    constructor(private font: string, public cellWidth: number, public cellHeight: number) {
+      this.canvas = document.createElement("canvas");
+      this.context = this.getContext(this.canvas);
+      this.grow(4);
+    }
+
+    private getContext(canvas: HTMLCanvasElement): CanvasRenderingContext2D {
+      const context = canvas.getContext("2d");
+      if (!context) throw new Error("No 2D canvas context");
+      return context;
+    }
+
+    // Double the number of rows, keeping the glyphs drawn so far.
+    private grow(rows: number) {
+      const old = this.canvas;
+      const canvas = document.createElement("canvas");
+      canvas.width = ATLAS_COLUMNS * this.cellWidth;
+      canvas.height = rows * this.cellHeight;
+      const context = this.getContext(canvas);
+      if (this.capacityRows > 0) context.drawImage(old, 0, 0);
+      context.font = this.font;
+      context.textAlign = "center";
+      context.textBaseline = "middle";
+      this.canvas = canvas;
+      this.context = context;
+      this.capacityRows = rows;
+    }
+
+    // \return the slot holding charCode drawn in rgb, rasterising it on first use.
+    public slot(charCode: number, rgb: number): number {
+      const key = charCode * 0x1000000 + rgb;
+      let slot = this.slots.get(key);
+      if (slot !== undefined) return slot;
+
+      slot = this.slots.size;
+      if (slot >= this.capacityRows * ATLAS_COLUMNS) this.grow(this.capacityRows * 2);
+      const x = (slot % ATLAS_COLUMNS) * this.cellWidth;
+      const y = Math.floor(slot / ATLAS_COLUMNS) * this.cellHeight;
+      this.context.fillStyle = rgbString(rgb);
+      this.context.fillText(String.fromCharCode(charCode), x + this.cellWidth / 2, y + this.cellHeight / 2);
+      this.slots.set(key, slot);
+      return slot;
+    }
+
+    // Copy a slot to (x, y) of the destination.
+    public draw(dest: CanvasRenderingContext2D, slot: number, x: number, y: number) {
+      const w = this.cellWidth, h = this.cellHeight;
+      const sx = (slot % ATLAS_COLUMNS) * w;
+      const sy = Math.floor(slot / ATLAS_COLUMNS) * h;
+      dest.drawImage(this.canvas, sx, sy, w, h, x, y, w, h);
+    }
+  }
+
+  // Paints the grid onto a single canvas: text is copied out of a glyph
+  // atlas and tiles straight out of the sprite sheets, so a repaint costs no
+  // style recalculation or layout.
+  class CanvasPainter implements Painter {
+    private context: CanvasRenderingContext2D;
+    private atlas: GlyphAtlas | undefined = undefined;
+    private sheets: Map<SpriteSheet, HTMLImageElement> = new Map();
+    private cellWidth: number = 0;
+    private cellHeight: number = 0;
+
+    // onSheetLoaded is called when a sprite sheet finishes loading, so that cells may be repainted.
+    constructor(public element: HTMLCanvasElement, private onSheetLoaded: () => void) {
+      const context = element.getContext("2d", { alpha: false });
+      if (!context) throw new Error("No 2D canvas context");
+      this.context = context;
+    }
+
+    // Size the canvas from the font, and start a new atlas in case the font changed.
+    rebuild(rows: number, columns: number) {
+      const style = getComputedStyle(this.element);
+      const font = `${style.fontWeight} ${style.fontSize} ${style.fontFamily}`;
+      const scale = window.devicePixelRatio || 1;
+
+      // Cells are as tall as the table's divs, 1.25em.
+      this.context.font = font;
+      const fontPixels = parseFloat(style.fontSize);
+      this.cellWidth = Math.ceil(this.context.measureText("M").width * scale);
+      this.cellHeight = Math.ceil(fontPixels * 1.25 * scale);
+      this.atlas = new GlyphAtlas(this.scaledFont(style, scale), this.cellWidth, this.cellHeight);
+
+      this.element.width = columns * this.cellWidth;
+      this.element.height = rows * this.cellHeight;
+      this.context.fillStyle = "#000000";
+      this.context.fillRect(0, 0, this.element.width, this.element.height);
+    }
+
+    // \return the canvas font at device pixel size.
+    private scaledFont(style: CSSStyleDeclaration, scale: number): string {
+      return `${style.fontWeight} ${parseFloat(style.fontSize) * scale}px ${style.fontFamily}`;
+    }
+
+    // \return the image for a sprite sheet, or undefined if it is still loading.
+    private sheetImage(sprites: SpriteSheet): HTMLImageElement | undefined {
+      let image = this.sheets.get(sprites);
+      if (!image) {
+        image = new Image();
+        image.onload = this.onSheetLoaded;
+        image.src = sprites.url;
+        this.sheets.set(sprites, image);
+      }
+      return image.complete && image.naturalWidth > 0 ? image : undefined;
+    }
+
+    // Draw one tile of a sprite sheet scaled to the cell at (x, y).
+    private drawSprite(image: HTMLImageElement, sprites: SpriteSheet, loc: SpriteLoc, x: number, y: number) {
+      const sw = image.naturalWidth / sprites.columns;
+      const sh = image.naturalHeight / sprites.rows;
+      this.context.drawImage(image, loc.col * sw, loc.row * sh, sw, sh, x, y, this.cellWidth, this.cellHeight);
+    }
+
+    paintCell(row: number, col: number, cell: Cell) {
+      const ctx = this.context;
+      const x = col * this.cellWidth;
+      const y = row * this.cellHeight;
+
+      ctx.fillStyle = "#000000";
+      ctx.fillRect(x, y, this.cellWidth, this.cellHeight);
+
+      if (cell.pict) {
+        const image = this.sheetImage(cell.pict.sprites);
+        if (image) {
+          if (cell.pict.terrain) this.drawSprite(image, cell.pict.sprites, cell.pict.terrain, x, y);
+          this.drawSprite(image, cell.pict.sprites, cell.pict.foreground, x, y);
+        }
+      } else if (cell.text && this.atlas) {
+        this.atlas.draw(ctx, this.atlas.slot(cell.text.charCodeAt(0), cell.rgb), x, y);
+      }
+
+      if (cell.cursor) {
+        const inset = CURSOR_WIDTH * (window.devicePixelRatio || 1);
+        ctx.strokeStyle = CURSOR_STROKE;
+        ctx.lineWidth = inset;
+        ctx.strokeRect(x + inset / 2, y + inset / 2, this.cellWidth - inset, this.cellHeight - inset);
+      }
+    }
+  }
+
+  export type RendererKind = "dom" | "canvas";
+
+  export class Grid {
+    public columns: number = 80;
+    public rows: number = 24;
+
+    cells: Row[] = [];
+    cursor: Cell | null = null;
+    painter: Painter;
+
+    displayRequest: number | undefined = undefined;
+
+    // The grid is drawn into the table or the canvas, whichever renderer is chosen.
+    constructor(public table: HTMLTableElement, public canvas: HTMLCanvasElement) {
+      this.painter = new DomPainter(table);
+    }
+
+    // Switch between the table and canvas renderers, and repaint everything.
+    public setRenderer(kind: RendererKind) {
+      this.painter.element.hidden = true;
+      if (kind === "canvas") {
+        this.painter = new CanvasPainter(this.canvas, this.repaintAll.bind(this));
+      } else {
+        this.painter = new DomPainter(this.table);
+      }
+      this.painter.element.hidden = false;
+      this.repaintAll();
+    }
+
+    // Rebuild whatever the painter draws into, and mark every cell to be redrawn.
+    // Used when the renderer, font or a sprite sheet changes.
+    public repaintAll() {
+      this.painter.rebuild(this.rows, this.columns);
+      this.cells.forEach((row) => {
+        row.forEach((cell) => {
+          cell.dirty = true;
+        });
+      });
+      this.setNeedsDisplay();
+    }
+
+    // Rebuild our cells.
+    rebuildCells() {
+      this.cursor = null;
+
+      this.cells.length = 0;
+      for (let row = 0; row < this.rows; row++) {
+        let rowlist = [];
+        for (let col = 0; col < this.columns; col++) {
+          rowlist.push(new Cell());
+        }
+        this.cells.push(rowlist);
+      }
+      this.painter.rebuild(this.rows, this.columns);
+    }
+
     // Get a cell, or throw.
     getCell(msg: { row: number, col: number }): Cell {
       let cell = undefined;
@@ -360,9 +602,12 @@ namespace angband {
     // Called by requestAnimationFrame to display dirty cells.
     private displayNow() {
       this.displayRequest = undefined;
-      this.cells.forEach((row) => {
-        row.forEach((cell) => {
-          cell.drawIfDirty();
+      const painter = this.painter;
+      this.cells.forEach((row, rowIdx) => {
+        row.forEach((cell, colIdx) => {
+          if (!cell.dirty) return;
+          cell.dirty = false;
+          painter.paintCell(rowIdx, colIdx, cell);
         });
       });
     }
@@ -437,6 +682,102 @@ namespace angband {
         this.displayNow();
       }
     }
+
+    // Apply the dirty rows of a frame, then flush.
+    // Cells are fed through setCell() and setCellPict() using scratch messages, so we do not allocate per cell.
+    public drawFrame(msg: RENDER_FRAME_MSG) {
+      const cells = new Int32Array(msg.cells);
+      const cols = msg.cols;
+      let text: SET_CELL_MSG = { name: "SET_CELL", row: 0, col: 0, charCode: 0, rgb: 0 };
+      let pict: SET_CELL_PICT_MSG = { name: "SET_CELL_PICT", row: 0, col: 0, mode: 0, pictRow: 0, pictCol: 0, terrRow: 0, terrCol: 0 };
+      msg.dirtyRows.forEach((row, idx) => {
+        for (let col = 0; col < cols; col++) {
+          const base = (idx * cols + col) * FRAME_CELL_WORDS;
+          if (cells[base] === FRAME_CELL_PICT) {
+            pict.row = row;
+            pict.col = col;
+            pict.mode = cells[base + 1];
+            pict.pictRow = cells[base + 2];
+            pict.pictCol = cells[base + 3];
+            pict.terrRow = cells[base + 4];
+            pict.terrCol = cells[base + 5];
+            this.setCellPict(pict);
+          } else {
+            text.row = row;
+            text.col = col;
+            text.charCode = cells[base + 1];
+            text.rgb = cells[base + 2];
+            this.setCell(text);
+          }
+        }
+      });
+      if (msg.cursorRow >= 0) {
+        this.setCursor({ name: "SET_CURSOR", row: msg.cursorRow, col: msg.cursorCol });
+      } else {
+        this.clearCursor();
+      }
+      this.flushDrawing({ name: "FLUSH_DRAWING" });
+    }
+  }
+
+  // Layout of the SHARED_INPUT buffer, copied from worker.ts.
+  const SHARED_SIGNAL = 0;
+  const SHARED_HEAD = 1;
+  const SHARED_TAIL = 2;
+  const SHARED_PRESENTED = 3;
+  const SHARED_TURBO = 4;
+  const SHARED_GRAPHICS = 5;
+  const SHARED_BORG = 6;
+  const SHARED_SAVEFILE = 7;
+  const SHARED_RING = 8;
+  const SHARED_RING_SLOTS = 256;
+
+  // IDBFS database layout, copied from Emscripten's library_idbfs.js.
+  // The database is named after the mount point, SAVE_DIR in worker.ts.
+  const SAVE_DB_NAME = "/lib/save";
+  const SAVE_DB_STORE = "FILE_DATA";
+  const SAVE_FILE_MODE = 0o100666;
+
+  // Delivers WorkerEvents to a SHARED_INPUT worker, which is blocked in Atomics.wait() rather than reading messages.
+  class SharedInput {
+    words: Int32Array;
+
+    constructor(buffer: SharedArrayBuffer) {
+      this.words = new Int32Array(buffer);
+    }
+
+    public post(msg: WorkerEvent) {
+      const words = this.words;
+      switch (msg.name) {
+        case 'KEY_EVENT': {
+          const head = Atomics.load(words, SHARED_HEAD);
+          // Like a full keyboard buffer, drop keys the game is too busy to read.
+          if (head - Atomics.load(words, SHARED_TAIL) >= SHARED_RING_SLOTS) return;
+          const slot = SHARED_RING + (head & (SHARED_RING_SLOTS - 1)) * 2;
+          words[slot] = msg.code;
+          words[slot + 1] = msg.modifiers;
+          Atomics.store(words, SHARED_HEAD, head + 1);
+          break;
+        }
+        case 'SET_TURBO':
+          Atomics.store(words, SHARED_TURBO, msg.value ? 1 : 0);
+          break;
+        case 'SET_GRAPHICS':
+          Atomics.store(words, SHARED_GRAPHICS, msg.mode);
+          break;
+        case 'ACTIVATE_BORG':
+          Atomics.store(words, SHARED_BORG, 1);
+          break;
+        case 'GET_SAVEFILE_CONTENTS':
+          Atomics.store(words, SHARED_SAVEFILE, 1);
+          break;
+        case 'FRAME_PRESENTED':
+          Atomics.add(words, SHARED_PRESENTED, 1);
+          break;
+      }
+      Atomics.add(words, SHARED_SIGNAL, 1);
+      Atomics.notify(words, SHARED_SIGNAL);
+    }
   }
 
   export class Status {
@@ -480,6 +821,13 @@ namespace angband {
   export class UI {
     worker: Worker;
 
+    // Set once a SHARED_INPUT worker has started; it then only reads this.
+    sharedInput: SharedInput | undefined = undefined;
+
+    // Frames painted, and frames the worker merged into them rather than sending.
+    public framesPresented: number = 0;
+    public framesCoalesced: number = 0;
+
     // Called when we receive a message from our WebWorker.
     onRenderEvent(msg: RenderEvent) {
       switch (msg.name) {
@@ -516,17 +864,24 @@ namespace angband {
           this.grid.flushDrawing(msg as FLUSH_DRAWING_MSG);
           break;
 
-        case 'BATCH_RENDER':
-          (msg as BATCH_RENDER_MSG).events.forEach((subevt) => {
-            this.onRenderEvent(subevt);
-          });
+        case 'RENDER_FRAME':
+          this.renderFrame(msg as RENDER_FRAME_MSG);
           break;
 
         case 'RESTART':
           /* Our worker has embarked upon a journey to the halls of Mandos. */
+          this.sharedInput = undefined;
           this.worker = this.summonWorkerFromPureNonexistence();
           break;
 
+        case 'SHARED_INPUT':
+          this.sharedInput = new SharedInput((msg as SHARED_INPUT_MSG).buffer);
+          break;
+
+        case 'SAVE_FILES':
+          this.storeSaveFiles(msg as SAVE_FILES_MSG);
+          break;
+
         case 'GOT_SAVEFILE':
           this.gotSavefile(msg as GOT_SAVEFILE_MSG);
           break;
@@ -541,6 +896,15 @@ namespace angband {
       }
     }
 
+    // Draw a frame, and tell the worker once it has reached the screen.
+    // The worker merges any frames flushed in the meantime, so we paint at most once per animation frame.
+    renderFrame(msg: RENDER_FRAME_MSG) {
+      this.grid.drawFrame(msg);
+      this.framesPresented++;
+      this.framesCoalesced += msg.coalesced;
+      requestAnimationFrame(() => this.postMessage({ name: "FRAME_PRESENTED" }));
+    }
+
     // Called when we receive a message from our WebWorker.
     onMessage(evt: MessageEvent) {
       this.onRenderEvent(evt.data as RenderEvent);
@@ -548,7 +912,32 @@ namespace angband {
 
     // Called to send a message to our WebWorker.
     postMessage(msg: WorkerEvent) {
-      this.worker.postMessage(msg);
+      if (this.sharedInput !== undefined) {
+        this.sharedInput.post(msg);
+      } else {
+        this.worker.postMessage(msg);
+      }
+    }
+
+    // Store savefiles sent by a SHARED_INPUT worker where IDBFS would have, so either build finds them.
+    storeSaveFiles(msg: SAVE_FILES_MSG) {
+      const request = indexedDB.open(SAVE_DB_NAME);
+      request.onupgradeneeded = () => {
+        const store = request.result.createObjectStore(SAVE_DB_STORE);
+        store.createIndex('timestamp', 'timestamp', { unique: false });
+      };
+      request.onerror = () => console.log("Unable to open the savefile database");
+      request.onsuccess = () => {
+        const db = request.result;
+        const transaction = db.transaction([SAVE_DB_STORE], 'readwrite');
+        const store = transaction.objectStore(SAVE_DB_STORE);
+        const timestamp = new Date();
+        for (const file of msg.files) {
+          store.put({ timestamp, mode: SAVE_FILE_MODE, contents: new Uint8Array(file.contents) }, file.path);
+        }
+        transaction.oncomplete = () => db.close();
+        transaction.onerror = () => console.log("Unable to store savefiles");
+      };
     }
 
     // Called when we receive a key event.
@@ -598,6 +987,28 @@ namespace angband {
       });
     }
 
+    // Draw with the table or canvas renderer.
+    public setRenderer(kind: RendererKind) {
+      this.grid.setRenderer(kind);
+    }
+
+    // Redraw everything after the font changed.
+    public refreshFont() {
+      this.grid.repaintAll();
+    }
+
+    // Log how many frames per second reach the screen over the next few seconds.
+    // Run it with the borg in turbo mode to compare renderers.
+    public measureFrameRate(seconds: number) {
+      const presented = this.framesPresented;
+      const coalesced = this.framesCoalesced;
+      setTimeout(() => {
+        const fps = (this.framesPresented - presented) / seconds;
+        const merged = (this.framesCoalesced - coalesced) / seconds;
+        console.log(`${fps.toFixed(1)} frames/s presented, ${merged.toFixed(1)} frames/s coalesced`);
+      }, seconds * 1000);
+    }
+
     // Let the user get their savefile.
     public requestDownloadSavefile() {
       this.postMessage({
@@ -638,7 +1049,8 @@ namespace angband {
 
     constructor(private grid: Grid, private status: Status, private printOutputElement: HTMLTextAreaElement) {
       // Touch triggers escape, so that the borg may be cancelled.
-      this.grid.element.addEventListener('touchstart', this.sendEscape.bind(this));
+      this.grid.table.addEventListener('touchstart', this.sendEscape.bind(this));
+      this.grid.canvas.addEventListener('touchstart', this.sendEscape.bind(this));
       this.grid.rebuildCells();
       this.worker = this.summonWorkerFromPureNonexistence();
     }
@@ -656,7 +1068,9 @@ const ANGBAND_UI: angband.UI = (function () {
     return getBaseElem(id) as Element as T;
   };
 
-  let grid = new angband.Grid(getElem<HTMLTableElement>('main-angband-grid'));
+  let grid = new angband.Grid(
+    getElem<HTMLTableElement>('main-angband-grid'),
+    getElem<HTMLCanvasElement>('main-angband-canvas'));
   let status = new angband.Status(
     getElem('angband-loadings'),
     getBaseElem('progress-ring-circle') as SVGCircleElement,
@@ -33,6 +33,8 @@ namespace angband {
   export class Settings {
     public setFont(name: string) {
       this.angbandGrid.style.fontFamily = name + ', mono';
+      this.angbandCanvas.style.fontFamily = name + ', mono';
+      ANGBAND_UI.refreshFont();
     }
 
     populateFonts() {
@@ -55,9 +57,12 @@ namespace angband {
 
     public setBold(flag: boolean) {
       this.angbandGrid.style.fontWeight = flag ? 'bold' : 'normal';
+      this.angbandCanvas.style.fontWeight = flag ? 'bold' : 'normal';
+      ANGBAND_UI.refreshFont();
     }
 
-    constructor(private controlsElem: HTMLElement, private fontSelectElem: HTMLSelectElement, private angbandGrid: HTMLTableElement) {
+    constructor(private controlsElem: HTMLElement, private fontSelectElem: HTMLSelectElement, private angbandGrid: HTMLTableElement,
+      private angbandCanvas: HTMLCanvasElement) {
       document.fonts.ready.then(this.populateFonts.bind(this));
     }
   }
@@ -74,6 +79,7 @@ const SETTINGS: angband.Settings = (function () {
     getElem('controls'),
     getElem('font-select'),
     getElem('main-angband-grid'),
+    getElem('main-angband-canvas'),
   );
   return settings;
 })();
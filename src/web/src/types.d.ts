@@ -56,9 +56,17 @@ declare namespace angband {
     name: "FLUSH_DRAWING";
   }
 
-  export interface BATCH_RENDER_MSG {
-    name: "BATCH_RENDER",
-    events: RenderEvent[],
+  // The changed rows of the screen, sent once per TERM_XTRA_FRESH.
+  // 'cells' holds dirtyRows.length rows of 'cols' cells, each of which is
+  // FRAME_CELL_WORDS int32s in the layout described in main-emscripten.c.
+  export interface RENDER_FRAME_MSG {
+    name: "RENDER_FRAME",
+    cols: number,
+    dirtyRows: number[],
+    cells: ArrayBuffer,
+    cursorRow: number, // -1 if the cursor is hidden
+    cursorCol: number,
+    coalesced: number, // number of earlier flushes merged into this frame
   }
 
   export interface RESTART_MSG {
@@ -70,11 +78,26 @@ declare namespace angband {
     contents: ArrayBuffer | undefined,
   }
 
+  // Sent once at startup by a SHARED_INPUT build (see Makefile.emscripten).
+  // The worker never returns to its event loop after this, so from then on every
+  // WorkerEvent is written into 'buffer' instead, in the layout described in worker.ts.
+  export interface SHARED_INPUT_MSG {
+    name: "SHARED_INPUT",
+    buffer: SharedArrayBuffer,
+  }
+
+  // The contents of the save directory, sent by a SHARED_INPUT build in place of an IDBFS sync.
+  // The renderer stores them in the same IndexedDB database IDBFS uses.
+  export interface SAVE_FILES_MSG {
+    name: "SAVE_FILES",
+    files: { path: string, contents: ArrayBuffer }[],
+  }
+
   // List of messages sent from ThreadWorker to Render.
   export type RenderEvent =
     ERROR_MSG | STATUS_MSG | PRINT_MSG | SET_CELL_MSG | SET_CELL_PICT_MSG |
     SET_CURSOR_MSG | WIPE_CELLS_MSG | CLEAR_SCREEN_MSG | FLUSH_DRAWING_MSG |
-    BATCH_RENDER_MSG | RESTART_MSG | GOT_SAVEFILE_MSG;
+    RENDER_FRAME_MSG | RESTART_MSG | GOT_SAVEFILE_MSG | SHARED_INPUT_MSG | SAVE_FILES_MSG;
 
   export interface KEY_EVENT_MSG {
     name: "KEY_EVENT",
@@ -101,6 +124,12 @@ declare namespace angband {
     name: "GET_SAVEFILE_CONTENTS",
   }
 
+  // Sent once a RENDER_FRAME has been painted, so the worker may send the next one.
+  export interface FRAME_PRESENTED_MSG {
+    name: "FRAME_PRESENTED",
+  }
+
   // Messages sent from Render to ThreadWorker.
-  export type WorkerEvent = KEY_EVENT_MSG | SET_TURBO_MSG | SET_GRAPHICS_MSG | ACTIVATE_BORG_MSG | GET_SAVEFILE_CONTENTS_MSG;
+  export type WorkerEvent = KEY_EVENT_MSG | SET_TURBO_MSG | SET_GRAPHICS_MSG | ACTIVATE_BORG_MSG | GET_SAVEFILE_CONTENTS_MSG |
+    FRAME_PRESENTED_MSG;
 }
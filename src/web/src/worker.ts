@@ -7,6 +7,7 @@ interface ModuleExports {
   callMain: (args?: string[]) => void;
   FS: FSType,
   IDBFS: Emscripten.FileSystemType,
+  _angband_shared_input?: () => number, // only in SHARED_INPUT builds
 }
 
 // Our module creation function, from Makefile.emscripten.
@@ -19,6 +20,38 @@ namespace angband {
     readonly modifiers: number;
   }
 
+  // Number of int32 words per cell in a RENDER_FRAME, copied from main-emscripten.c.
+  const FRAME_CELL_WORDS = 6;
+
+  // Screen changes accumulated between RENDER_FRAME messages.
+  // The cell contents stay in the wasm heap until the frame is sent.
+  interface PendingFrame {
+    heap: Int32Array;
+    cellsPtr: number;
+    rows: number;
+    cols: number;
+    dirty: boolean[];
+    cursorRow: number;
+    cursorCol: number;
+    coalesced: number; // number of flushes merged into this one
+  }
+
+  // Layout of the SHARED_INPUT buffer, as int32 words.
+  // The renderer writes; we only read, apart from SHARED_TAIL and the request flags we clear.
+  const SHARED_SIGNAL = 0;      // bumped and notified after every write; we Atomics.wait() on it
+  const SHARED_HEAD = 1;        // key events written
+  const SHARED_TAIL = 2;        // key events read
+  const SHARED_PRESENTED = 3;   // frames presented
+  const SHARED_TURBO = 4;       // nonzero for turbo
+  const SHARED_GRAPHICS = 5;    // graphics mode
+  const SHARED_BORG = 6;        // set to activate the borg
+  const SHARED_SAVEFILE = 7;    // set to ask for the savefile contents
+  const SHARED_RING = 8;        // key ring: code, modifiers per slot
+  const SHARED_RING_SLOTS = 256; // a power of two
+
+  // Where savefiles live, in the FS and as the name of the IDBFS database.
+  const SAVE_DIR = "/lib/save";
+
   // A special "wake up" event which is ignored on the C side.
   const WAKE_UP_EVENT: KeyEvent = {
     key: "",
@@ -37,8 +70,11 @@ namespace angband {
     // Callback to resolve the promise.
     eventPromiseCallback: (val: boolean) => void;
 
-    // Enqueued render events, to be sent in flushDrawing().
-    enqueuedRenderEvents: RenderEvent[] = [];
+    // Changes flushed from C but not yet sent to the renderer, if any.
+    pendingFrame: PendingFrame | undefined = undefined;
+
+    // Whether the renderer has yet to paint the last frame we sent.
+    frameInFlight: boolean = false;
 
     // Emscripten gets salty if we have multiple fsyncs going at once.
     fsyncRequested: boolean = false;
@@ -56,6 +92,14 @@ namespace angband {
     // Whee!
     public turbo: boolean = false;
 
+    // The SHARED_INPUT buffer, if this build blocks on it rather than using ASYNCIFY.
+    shared: Int32Array | undefined = undefined;
+
+    // Shared words as of our last look, so we only act on changes.
+    sharedPresented: number = 0;
+    sharedTurbo: number = 0;
+    sharedGraphics: number = 0;
+
     // The module object.
     // This is set once the module is loaded.
     public module: ModuleExports | undefined = undefined;
@@ -111,17 +155,17 @@ namespace angband {
       }
     }
 
-    setActivateBorg(_msg: ACTIVATE_BORG_MSG) {
+    setActivateBorg() {
       this.activateBorg = true;
       this.postKeyEvent(WAKE_UP_EVENT);
     }
 
-    getSavefileContents(_msg: GET_SAVEFILE_CONTENTS_MSG) {
+    getSavefileContents() {
       // We could go through C but it is easier to just use the FS API.
       // Here we hard-code the Angband savefile name.
       let contents: ArrayBuffer | undefined;
       try {
-        let data = this.fs().readFile("/lib/save/PLAYER");
+        let data = this.fs().readFile(SAVE_DIR + "/PLAYER");
         contents = data.buffer.slice(data.byteOffset, data.byteLength + data.byteOffset);
       } catch (_err) {
         // e.g. file not found
@@ -144,14 +188,17 @@ namespace angband {
         case 'SET_TURBO':
           this.turbo = (evt as SET_TURBO_MSG).value;
           break;
+        case 'FRAME_PRESENTED':
+          this.framePresented();
+          break;
         case 'SET_GRAPHICS':
           this.setGraphicsMode((evt as SET_GRAPHICS_MSG).mode);
           break;
         case 'ACTIVATE_BORG':
-          this.setActivateBorg(evt as ACTIVATE_BORG_MSG);
+          this.setActivateBorg();
           break;
         case 'GET_SAVEFILE_CONTENTS':
-          this.getSavefileContents(evt as GET_SAVEFILE_CONTENTS_MSG);
+          this.getSavefileContents();
           break;
         default:
           this.reportError("Unknown event: " + JSON.stringify(evt));
@@ -202,20 +249,102 @@ namespace angband {
       return this.module.FS;
     }
 
+    // Run the game.
+    // A SHARED_INPUT build never returns to our event loop once main() starts,
+    // so the renderer is switched over and savefiles are loaded first.
+    public start() {
+      const module = this.module;
+      if (module === undefined) throw new Error("Module not set");
+      if (module._angband_shared_input === undefined) {
+        module.callMain();
+        return;
+      }
+      if (typeof SharedArrayBuffer === 'undefined') {
+        this.reportError("SharedArrayBuffer is unavailable: this page must be served cross-origin isolated.");
+        return;
+      }
+      const buffer = new SharedArrayBuffer((SHARED_RING + SHARED_RING_SLOTS * 2) * 4);
+      this.shared = new Int32Array(buffer);
+      const msg: SHARED_INPUT_MSG = {
+        name: "SHARED_INPUT",
+        buffer,
+      };
+      this.postMessage(msg);
+      this.initializeFilesystem(() => module.callMain());
+    }
+
+    // \return the SHARED_INPUT buffer, asserting that we have one.
+    sharedWords(): Int32Array {
+      if (this.shared === undefined) throw new Error("No shared input");
+      return this.shared;
+    }
+
+    // Pick up everything the renderer has written to the shared buffer since we last looked.
+    pollShared(shared: Int32Array) {
+      const head = Atomics.load(shared, SHARED_HEAD);
+      let tail = Atomics.load(shared, SHARED_TAIL);
+      for (; tail !== head; tail++) {
+        const slot = SHARED_RING + (tail & (SHARED_RING_SLOTS - 1)) * 2;
+        this.eventQueue.push({ key: "", code: shared[slot], modifiers: shared[slot + 1] });
+      }
+      Atomics.store(shared, SHARED_TAIL, tail);
+
+      const turbo = Atomics.load(shared, SHARED_TURBO);
+      if (turbo !== this.sharedTurbo) {
+        this.sharedTurbo = turbo;
+        this.turbo = turbo !== 0;
+      }
+      const graphics = Atomics.load(shared, SHARED_GRAPHICS);
+      if (graphics !== this.sharedGraphics) {
+        this.sharedGraphics = graphics;
+        this.setGraphicsMode(graphics);
+      }
+      if (Atomics.exchange(shared, SHARED_BORG, 0)) this.setActivateBorg();
+      if (Atomics.exchange(shared, SHARED_SAVEFILE, 0)) this.getSavefileContents();
+      const presented = Atomics.load(shared, SHARED_PRESENTED);
+      if (presented !== this.sharedPresented) {
+        this.sharedPresented = presented;
+        this.framePresented();
+      }
+    }
+
+    // Hand the save directory to the renderer, which stores it in the IDBFS database.
+    // IDBFS cannot sync by itself here, as IndexedDB needs the event loop we never return to.
+    sendSaveFiles() {
+      const fs = this.fs();
+      let files: { path: string, contents: ArrayBuffer }[] = [];
+      for (const name of fs.readdir(SAVE_DIR)) {
+        const path = SAVE_DIR + "/" + name;
+        if (!fs.isFile(fs.stat(path).mode)) continue;
+        const data = fs.readFile(path);
+        files.push({ path, contents: data.buffer.slice(data.byteOffset, data.byteLength + data.byteOffset) });
+      }
+      const msg: SAVE_FILES_MSG = {
+        name: "SAVE_FILES",
+        files,
+      };
+      this.worker.postMessage(msg, files.map((file) => file.contents));
+    }
+
     /** The following functions are called from emscripten **/
 
     // Called from C to perform any initial setup.
-    public initializeFilesystem() {
+    // 'then' runs once any existing savefiles have been loaded.
+    public initializeFilesystem(then?: () => void) {
       if (this.fsInitialized) return;
       if (this.module === undefined) throw new Error("Module not set");
       this.fsInitialized = true;
-      this.fs().mkdir("/lib/save");
-      this.fs().mount(this.module.IDBFS, {}, "/lib/save");
-      this.fsync(true /* populate */);
+      this.fs().mkdir(SAVE_DIR);
+      this.fs().mount(this.module.IDBFS, {}, SAVE_DIR);
+      this.fsync(true /* populate */, then);
     }
 
     // Called to trigger an syncfs().
-    public fsync(populate: boolean | undefined) {
+    public fsync(populate?: boolean, then?: () => void) {
+      if (this.shared !== undefined && !populate) {
+        this.sendSaveFiles();
+        return;
+      }
       if (this.fsyncInFlight) {
         this.fsyncRequested = true;
         return;
@@ -226,6 +355,7 @@ namespace angband {
       this.fsyncInFlight = true;
       this.fs().syncfs(populate || false, (err) => {
         if (err) ANGBAND.reportError(JSON.stringify(err));
+        if (then) then();
 
         // fsync is complete. Perhaps run another one.
         this.fsyncInFlight = false;
@@ -248,75 +378,70 @@ namespace angband {
       this.worker.terminate();
     }
 
-    // Set a cell at (row, col) to the given character code, with the given color.
-    public setCell(row: number, col: number, charCode: number, rgb: number) {
-      const msg: SET_CELL_MSG = {
-        name: "SET_CELL",
-        row,
-        col,
-        charCode,
-        rgb,
-      };
-      this.enqueuedRenderEvents.push(msg);
-    }
-
-    // Draw a picture in a cell. The 'mode' is an index into the "graphics.txt" document.
-    public setCellPict(row: number, col: number, mode: number, pictRow: number, pictCol: number, terrRow: number, terrCol: number) {
-      const msg: SET_CELL_PICT_MSG = {
-        name: "SET_CELL_PICT",
-        row,
-        col,
-        mode,
-        pictRow,
-        pictCol,
-        terrRow,
-        terrCol,
-      };
-      this.enqueuedRenderEvents.push(msg);
-    }
-
-    // Wipe N cells at (row, column).
-    public wipeCells(row: number, col: number, count: number) {
-      if (count <= 0) return;
-      const msg: WIPE_CELLS_MSG = {
-        name: "WIPE_CELLS",
-        row,
-        col,
-        count,
-      };
-      this.enqueuedRenderEvents.push(msg);
-    }
-
-    // Clear the entire screen.
-    public clearScreen() {
-      const msg: CLEAR_SCREEN_MSG = {
-        name: "CLEAR_SCREEN"
-      };
-      this.enqueuedRenderEvents.push(msg);
+    // Called from C on TERM_XTRA_FRESH with the frame buffer from main-emscripten.c.
+    // Remember which rows changed, and send them now if the renderer is ready for another frame.
+    // We never wait for the renderer: if a frame is still being painted, this one is merged into the next.
+    public drawFrame(heap: Int32Array, cellsPtr: number, dirtyPtr: number, rows: number, cols: number, cursorRow: number, cursorCol: number) {
+      let frame = this.pendingFrame;
+      if (frame === undefined || frame.rows !== rows || frame.cols !== cols) {
+        frame = {
+          heap, cellsPtr, rows, cols, cursorRow, cursorCol,
+          dirty: new Array(rows).fill(false),
+          coalesced: 0,
+        };
+        this.pendingFrame = frame;
+      } else {
+        // There were unsent changes; this frame absorbs them.
+        frame.heap = heap;
+        frame.cellsPtr = cellsPtr;
+        frame.cursorRow = cursorRow;
+        frame.cursorCol = cursorCol;
+        frame.coalesced++;
+      }
+      const dirtyBase = dirtyPtr >> 2;
+      for (let row = 0; row < rows; row++) {
+        if (heap[dirtyBase + (row >> 5)] & (1 << (row & 31))) frame.dirty[row] = true;
+      }
+      if (!this.frameInFlight) this.sendPendingFrame();
     }
 
-    // Flush all drawing to the screen. Note this can affect frame rates.
-    public flushDrawing() {
-      const flush: FLUSH_DRAWING_MSG = {
-        name: "FLUSH_DRAWING"
-      };
-      this.enqueuedRenderEvents.push(flush);
-      const batch: BATCH_RENDER_MSG = {
-        name: "BATCH_RENDER",
-        events: this.enqueuedRenderEvents,
+    // Copy the dirty rows of the pending frame out of the wasm heap and hand them to the renderer in a single transferable message.
+    // Rows are read at send time, so cells overwritten by merged frames are only sent once.
+    // Note this relies on the wasm memory not growing, which would detach the stored heap view.
+    sendPendingFrame() {
+      const frame = this.pendingFrame;
+      if (frame === undefined) return;
+      this.pendingFrame = undefined;
+
+      const { heap, rows, cols } = frame;
+      const rowWords = cols * FRAME_CELL_WORDS;
+      const cellsBase = frame.cellsPtr >> 2;
+      let dirtyRows: number[] = [];
+      for (let row = 0; row < rows; row++) {
+        if (frame.dirty[row]) dirtyRows.push(row);
+      }
+      let cells = new Int32Array(dirtyRows.length * rowWords);
+      dirtyRows.forEach((row, idx) => {
+        const start = cellsBase + row * rowWords;
+        cells.set(heap.subarray(start, start + rowWords), idx * rowWords);
+      });
+      const msg: RENDER_FRAME_MSG = {
+        name: "RENDER_FRAME",
+        cols,
+        dirtyRows,
+        cells: cells.buffer,
+        cursorRow: frame.cursorRow,
+        cursorCol: frame.cursorCol,
+        coalesced: frame.coalesced,
       };
-      this.enqueuedRenderEvents = [];
-      this.postMessage(batch);
+      this.frameInFlight = true;
+      this.worker.postMessage(msg, [cells.buffer]);
     }
 
-    // Move the cursor to a cell.
-    public setCursor(row: number, col: number) {
-      const msg: SET_CURSOR_MSG = {
-        name: "SET_CURSOR",
-        row,
-        col,
-      };
-      this.enqueuedRenderEvents.push(msg);
+    // Called when the renderer has painted the last frame we sent.
+    framePresented() {
+      this.frameInFlight = false;
+      this.sendPendingFrame();
     }
 
     // Wait for events, optionally blocking.
@@ -338,6 +463,32 @@ namespace angband {
       }
     }
 
+    // Wait for events in a SHARED_INPUT build, optionally blocking.
+    // The whole worker sleeps in Atomics.wait() until the renderer writes something.
+    public gatherEventNow(block: boolean): boolean {
+      const shared = this.sharedWords();
+      for (;;) {
+        const signal = Atomics.load(shared, SHARED_SIGNAL);
+        this.pollShared(shared);
+        if (this.hasEvent() || !block) return this.hasEvent();
+        Atomics.wait(shared, SHARED_SIGNAL, signal);
+      }
+    }
+
+    // Pause for TERM_XTRA_DELAY in a SHARED_INPUT build.
+    // We keep polling meanwhile, so frames still go out and turbo cuts the pause short.
+    public sleep(ms: number) {
+      const shared = this.sharedWords();
+      const deadline = performance.now() + ms;
+      for (;;) {
+        const signal = Atomics.load(shared, SHARED_SIGNAL);
+        this.pollShared(shared);
+        const remaining = deadline - performance.now();
+        if (remaining <= 0 || this.turbo) return;
+        Atomics.wait(shared, SHARED_SIGNAL, signal, remaining);
+      }
+    }
+
     // \return the key code for the current event.
     public eventKeyCode(): number {
       return this.eventQueue[0].code;
@@ -388,7 +539,7 @@ try {
   };
   createAngbandModule(moduleDefaults).then((module: ModuleExports) => {
     ANGBAND.module = module;
-    module.callMain();
+    ANGBAND.start();
   });
 } catch (error) {
   ANGBAND.reportError(error.message);
@@ -1462,7 +1462,10 @@ static bool stats_monster(monster_type *m_ptr, int i)
 		uniq_total[lvl] += addval;
 	
 		/* kill the unique if we're in clearing mode */
-		if (clearing) r_ptr->max_num = 0;
+		if (clearing) {
+			r_ptr->max_num = 0;
+			get_mon_num_reset();
+		}
 		
 		//debugging print that we killed it
 		//msg_format("Killed %s",r_ptr->name);
@@ -2119,6 +2122,8 @@ static void revive_uniques(void)
 		if (rf_has(r_ptr->flags, RF_UNIQUE)) r_ptr->max_num = 1;
 
 	}
+
+	get_mon_num_reset();
 		
 }	
 /* 
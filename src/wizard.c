@@ -127,7 +127,7 @@ static void do_cmd_wiz_hack_ben(void)
 				if (cave->cost[y][x] != i) continue;
 
 				/* Reliability in yellow */
-				if (cave->when[y][x] == cave->when[py][px])
+				if (cave_flow_when(cave, y, x) == cave_flow_when(cave, py, px))
 					a = TERM_YELLOW;
 
 				/* Display player/floors/walls */
@@ -218,6 +218,21 @@ static void do_cmd_keylog(void) {
 }
 
 
+/*
+ * Show the work done by update_monsters() since the last time
+ */
+static void do_cmd_wiz_monster_updates(void)
+{
+	struct monster_update_count *c = &mon_update_count;
+
+	msg("%lu updates visited %lu monsters and skipped %lu.",
+		(unsigned long)c->calls, (unsigned long)c->visited,
+		(unsigned long)c->skipped);
+
+	WIPE(c, struct monster_update_count);
+}
+
+
 /*
  * Hack -- Teleport to the target
  */
@@ -641,8 +656,10 @@ static void wiz_tweak_item(object_type *o_ptr)
 	if (val) {
 		o_ptr->ego = &e_info[val];
 		ego_apply_magic(o_ptr, p_ptr->depth);
-	} else
+	} else {
 		o_ptr->ego = 0;
+		object_flags_forget(o_ptr);
+	}
 	wiz_display_item(o_ptr, TRUE);
 
 	p = "Enter new artifact index: ";
@@ -1015,6 +1032,8 @@ static void wiz_tweak_curse(object_type *o_ptr)
 		flags_set(o_ptr->flags, OF_SIZE, OF_LIGHT_CURSE, OF_HEAVY_CURSE, FLAG_END);
 	else if (get_check("Set permanent curse? "))
 		flags_set(o_ptr->flags, OF_SIZE, OF_LIGHT_CURSE, OF_HEAVY_CURSE, OF_PERMA_CURSE, FLAG_END);
+
+	object_flags_forget(o_ptr);
 }
 
 
@@ -1781,6 +1800,9 @@ void do_cmd_debug(void)
 
 		case 'L': do_cmd_keylog(); break;
 
+		/* Monster update counts */
+		case 'M': do_cmd_wiz_monster_updates(); break;
+
 		/* Magic Mapping */
 		case 'm':
 		{
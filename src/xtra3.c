@@ -1286,7 +1286,7 @@ static void update_messages_subwindow(game_event_type type, game_event_data *dat
 static struct minimap_flags
 {
 	int win_idx;
-	bool needs_redraw;
+	struct minimap map;
 } minimap_data[ANGBAND_TERM_MAX];
 
 static void update_minimap_subwindow(game_event_type type,
@@ -1294,25 +1294,22 @@ static void update_minimap_subwindow(game_event_type type,
 {
 	struct minimap_flags *flags = user;
 
-	if (type == EVENT_END) {
+	if (type == EVENT_MAP) {
+		/* Note the changed grid */
+		minimap_mark(&flags->map, data->point.y, data->point.x);
+	} else if (type == EVENT_END) {
 		term *old = Term;
 		term *t = angband_term[flags->win_idx];
 		
 		/* Activate */
 		Term_activate(t);
 
-		/* If whole-map redraw, clear window first. */
-		if (flags->needs_redraw)
-			Term_clear();
-
 		/* Redraw map */
-		display_map(NULL, NULL);
+		minimap_display(&flags->map);
 		Term_fresh();
 		
 		/* Restore */
 		Term_activate(old);
-
-		flags->needs_redraw = FALSE;
 	}
 }
 
@@ -1516,6 +1513,7 @@ static void subwindow_flag_changed(int win_idx, u32b flag, bool new_state)
 		case PW_OVERHEAD:
 		{
 			minimap_data[win_idx].win_idx = win_idx;
+			minimap_free(&minimap_data[win_idx].map);
 
 			register_or_deregister(EVENT_MAP,
 					       update_minimap_subwindow,
@@ -1562,6 +1560,18 @@ static void subwindow_flag_changed(int win_idx, u32b flag, bool new_state)
 }
 
 
+/*
+ * Free the minimaps of any overhead subwindows.
+ */
+void subwindows_free(void)
+{
+	size_t i;
+
+	for (i = 0; i < N_ELEMENTS(minimap_data); i++)
+		minimap_free(&minimap_data[i].map);
+}
+
+
 /*
  * Set the flags for one Term, calling "subwindow_flag_changed" with each flag that
  * has changed setting so that it can do any housekeeping to do with 
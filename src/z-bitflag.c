@@ -18,6 +18,27 @@
 
 #include "z-bitflag.h"
 
+/*
+ * Most operations on whole bitfields work a machine word at a time, with any
+ * bytes left over at the end done one by one.  Bitfields need not be aligned,
+ * so words are moved in and out with memcpy(), which compilers turn into
+ * plain loads and stores.
+ */
+typedef size_t flag_word;
+#define FLAG_WORD	sizeof(flag_word)
+
+static flag_word flag_load(const bitflag *flags)
+{
+	flag_word w;
+	memcpy(&w, flags, FLAG_WORD);
+	return w;
+}
+
+static void flag_store(bitflag *flags, flag_word w)
+{
+	memcpy(flags, &w, FLAG_WORD);
+}
+
 
 /**
  * Tests if a flag is "on" in a bitflag set.
@@ -71,14 +92,28 @@ bool flag_has_dbg(const bitflag *flags, const size_t size, const int flag, const
 int flag_next(const bitflag *flags, const size_t size, const int flag)
 {
 	const int max_flags = FLAG_MAX(size);
-	int f, flag_offset, flag_binary;
+	int f = flag;
 
-	for (f = flag; f < max_flags; f++)
+	while (f < max_flags)
 	{
-		flag_offset = FLAG_OFFSET(f);
-		flag_binary = FLAG_BINARY(f);
+		size_t flag_offset = FLAG_OFFSET(f);
+		int flag_binary = FLAG_BINARY(f);
+
+		/* The rest of this byte is empty, so skip to the next one */
+		if (!(flags[flag_offset] & ~(flag_binary - 1)))
+		{
+			f = FLAG_MAX(flag_offset + 1);
+
+			/* Skip whole empty words */
+			while ((size_t)FLAG_OFFSET(f) + FLAG_WORD <= size &&
+			       !flag_load(flags + FLAG_OFFSET(f)))
+				f += FLAG_WORD * FLAG_WIDTH;
+
+			continue;
+		}
 
 		if (flags[flag_offset] & flag_binary) return f;
+		f++;
 	}
 
 	return FLAG_END;
@@ -95,7 +130,10 @@ bool flag_is_empty(const bitflag *flags, const size_t size)
 {
 	size_t i;
 
-	for (i = 0; i < size; i++)
+	for (i = 0; i + FLAG_WORD <= size; i += FLAG_WORD)
+		if (flag_load(flags + i)) return FALSE;
+
+	for (; i < size; i++)
 		if (flags[i] > 0) return FALSE;
 
 	return TRUE;
@@ -112,7 +150,10 @@ bool flag_is_full(const bitflag *flags, const size_t size)
 {
 	size_t i;
 
-	for (i = 0; i < size; i++)
+	for (i = 0; i + FLAG_WORD <= size; i += FLAG_WORD)
+		if (flag_load(flags + i) != (flag_word) -1) return FALSE;
+
+	for (; i < size; i++)
 		if (flags[i] != (bitflag) -1) return FALSE;
 
 	return TRUE;
@@ -129,7 +170,10 @@ bool flag_is_inter(const bitflag *flags1, const bitflag *flags2, const size_t si
 {
 	size_t i;
 
-	for (i = 0; i < size; i++)
+	for (i = 0; i + FLAG_WORD <= size; i += FLAG_WORD)
+		if (flag_load(flags1 + i) & flag_load(flags2 + i)) return TRUE;
+
+	for (; i < size; i++)
 		if (flags1[i] & flags2[i]) return TRUE;
 
 	return FALSE;
@@ -146,7 +190,10 @@ bool flag_is_subset(const bitflag *flags1, const bitflag *flags2, const size_t s
 {
 	size_t i;
 
-	for (i = 0; i < size; i++)
+	for (i = 0; i + FLAG_WORD <= size; i += FLAG_WORD)
+		if (~flag_load(flags1 + i) & flag_load(flags2 + i)) return FALSE;
+
+	for (; i < size; i++)
 		if (~flags1[i] & flags2[i]) return FALSE;
 
 	return TRUE;
@@ -259,8 +306,11 @@ void flag_setall(bitflag *flags, const size_t size)
 void flag_negate(bitflag *flags, const size_t size)
 {
 	size_t i;
-	
-	for (i = 0; i < size; i++)
+
+	for (i = 0; i + FLAG_WORD <= size; i += FLAG_WORD)
+		flag_store(flags + i, ~flag_load(flags + i));
+
+	for (; i < size; i++)
 		flags[i] = ~flags[i];
 }
 
@@ -287,17 +337,28 @@ void flag_copy(bitflag *flags1, const bitflag *flags2, const size_t size)
 bool flag_union(bitflag *flags1, const bitflag *flags2, const size_t size)
 {
 	size_t i;
-	bool delta = FALSE;
+	flag_word delta = 0;
 
-	for (i = 0; i < size; i++)
+	for (i = 0; i + FLAG_WORD <= size; i += FLAG_WORD)
+	{
+		flag_word w1 = flag_load(flags1 + i);
+		flag_word w2 = flag_load(flags2 + i);
+
+		/* !flag_is_subset() */
+		delta |= ~w1 & w2;
+
+		flag_store(flags1 + i, w1 | w2);
+	}
+
+	for (; i < size; i++)
 	{
 		/* !flag_is_subset() */
-		if (~flags1[i] & flags2[i]) delta = TRUE;
+		delta |= ~flags1[i] & flags2[i];
 
 		flags1[i] |= flags2[i];
 	}
 
-	return delta;
+	return delta ? TRUE : FALSE;
 }
 
 
@@ -335,18 +396,28 @@ bool flag_comp_union(bitflag *flags1, const bitflag *flags2, const size_t size)
 bool flag_inter(bitflag *flags1, const bitflag *flags2, const size_t size)
 {
 	size_t i;
-	bool delta = FALSE;
+	flag_word delta = 0;
 
-	for (i = 0; i < size; i++)
+	for (i = 0; i + FLAG_WORD <= size; i += FLAG_WORD)
 	{
+		flag_word w1 = flag_load(flags1 + i);
+		flag_word w2 = flag_load(flags2 + i);
+
 		/* !flag_is_equal() */
-		if (!(flags1[i] == flags2[i])) delta = TRUE;
+		delta |= w1 ^ w2;
 
-		flags1[i] &= flags2[i];
+		flag_store(flags1 + i, w1 & w2);
 	}
 
-	return delta;
+	for (; i < size; i++)
+	{
+		/* !flag_is_equal() */
+		delta |= flags1[i] ^ flags2[i];
 
+		flags1[i] &= flags2[i];
+	}
+
+	return delta ? TRUE : FALSE;
 }
 
 
@@ -360,17 +431,28 @@ bool flag_inter(bitflag *flags1, const bitflag *flags2, const size_t size)
 bool flag_diff(bitflag *flags1, const bitflag *flags2, const size_t size)
 {
 	size_t i;
-	bool delta = FALSE;
+	flag_word delta = 0;
 
-	for (i = 0; i < size; i++)
+	for (i = 0; i + FLAG_WORD <= size; i += FLAG_WORD)
 	{
+		flag_word w1 = flag_load(flags1 + i);
+		flag_word w2 = flag_load(flags2 + i);
+
 		/* flag_is_inter() */
-		if (flags1[i] & flags2[i]) delta = TRUE;
+		delta |= w1 & w2;
+
+		flag_store(flags1 + i, w1 & ~w2);
+	}
+
+	for (; i < size; i++)
+	{
+		/* flag_is_inter() */
+		delta |= flags1[i] & flags2[i];
 
 		flags1[i] &= ~flags2[i];
 	}
 
-	return delta;
+	return delta ? TRUE : FALSE;
 }
 
 
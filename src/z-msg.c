@@ -18,11 +18,15 @@
 #include "z-term.h"
 #include "z-msg.h"
 
+/*
+ * Messages are kept in a fixed-size ring, newest at 'head'.  Each slot owns a
+ * text buffer which is reused when the slot is overwritten, so once the ring
+ * has filled up adding a message rarely needs to allocate.
+ */
 typedef struct _message_t
 {
 	char *str;
-	struct _message_t *newer;
-	struct _message_t *older;
+	size_t size;
 	u16b type;
 	u16b count;
 } message_t;
@@ -36,20 +40,24 @@ typedef struct _msgcolor_t
 
 typedef struct _msgqueue_t
 {
-	message_t *head;
-	message_t *tail;
+	message_t *ring;
 	msgcolor_t *colors;
+	u32b head;
 	u32b count;
 	u32b max;
 } msgqueue_t;
 
 static msgqueue_t *messages = NULL;
 
+/* Smallest text buffer given to a slot */
+#define MESSAGE_MIN_SIZE	80
+
 /* Functions operating on the entire list */
 errr messages_init(void)
 {
 	messages = ZNEW(msgqueue_t);
 	messages->max = 2048;
+	messages->ring = C_ZNEW(messages->max, message_t);
 	return 0;
 }
 
@@ -57,16 +65,11 @@ void messages_free(void)
 {
 	msgcolor_t *c = messages->colors;
 	msgcolor_t *nextc;
-	message_t *m = messages->head;
-	message_t *nextm;
+	u32b i;
 
-	while (m)
-	{
-		nextm = m->older;
-		FREE(m->str);
-		FREE(m);
-		m = nextm;
-	}
+	for (i = 0; i < messages->max; i++)
+		FREE(messages->ring[i].str);
+	FREE(messages->ring);
 
 	while (c)
 	{
@@ -85,53 +88,40 @@ u16b messages_num(void)
 
 /* Functions for individual messages */
 
+static message_t *message_get(u16b age)
+{
+	if (age >= messages->count)
+		return NULL;
+
+	return &messages->ring[(messages->head + messages->max - age) % messages->max];
+}
+
 void message_add(const char *str, u16b type)
 {
-	message_t *m;
+	message_t *m = message_get(0);
+	size_t len = strlen(str) + 1;
 
-	if (messages->head &&
-	    messages->head->type == type &&
-	    !strcmp(messages->head->str, str))
+	if (m && m->type == type && !strcmp(m->str, str))
 	{
-		messages->head->count++;
+		m->count++;
 		return;
 	}
 
-	m = ZNEW(message_t);
-	m->str = string_make(str);
-	m->type = type;
-	m->count = 1;
-	m->older = messages->head;
+	/* Take over the next slot, overwriting the oldest message if full */
+	messages->head = (messages->head + 1) % messages->max;
+	if (messages->count < messages->max)
+		messages->count++;
 
-	if (messages->head)
-		messages->head->newer = m;
-
-	messages->head = m;
-	messages->count++;
-
-	if (!messages->tail)
-		messages->tail = m;
-
-	if (messages->count > messages->max)
+	m = &messages->ring[messages->head];
+	if (m->size < len)
 	{
-		message_t *old_tail = messages->tail;
-
-		messages->tail = old_tail->newer;
-		messages->tail->older = NULL;
-		FREE(old_tail->str);
-		FREE(old_tail);
-		messages->count--;
+		m->size = MAX(len, MESSAGE_MIN_SIZE);
+		m->str = mem_realloc(m->str, m->size);
 	}
-}
 
-static message_t *message_get(u16b age)
-{
-	message_t *m = messages->head;
-
-	while (m && age--)
-		m = m->older;
-
-	return m;
+	memcpy(m->str, str, len);
+	m->type = type;
+	m->count = 1;
 }
 
 
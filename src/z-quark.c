@@ -26,16 +26,108 @@ static size_t alloc_quarks = 0;
 
 #define QUARKS_INIT	16
 
-quark_t quark_add(const char *str)
+/*
+ * The quark index is an open-addressed hash table of quark numbers, kept at
+ * most half full.  Quark 0 is never handed out, so it marks an empty slot.
+ */
+static quark_t *quark_index;
+static size_t alloc_index = 0;
+
+#define QUARK_INDEX_INIT	(QUARKS_INIT * 2)
+
+/*
+ * Quark strings are never freed individually, so they are packed into large
+ * blocks rather than allocated one at a time.  Each block starts with a
+ * pointer to the previous block so they can all be freed together.
+ */
+static char *arena_block;
+static size_t arena_used = 0;
+static size_t arena_size = 0;
+
+#define ARENA_BLOCK_SIZE	8192
+
+
+/*
+ * FNV-1a hash of a string.
+ */
+static u32b quark_hash(const char *str)
+{
+	u32b h = 2166136261UL;
+
+	while (*str)
+	{
+		h ^= (byte)*str++;
+		h *= 16777619UL;
+	}
+
+	return h;
+}
+
+/*
+ * Return the index slot for 'str': either the slot holding its quark, or the
+ * empty slot where it would go.
+ */
+static size_t quark_slot(const char *str)
+{
+	size_t mask = alloc_index - 1;
+	size_t i = quark_hash(str) & mask;
+
+	while (quark_index[i] && strcmp(quarks[quark_index[i]], str))
+		i = (i + 1) & mask;
+
+	return i;
+}
+
+/*
+ * Double the size of the index and rehash every quark into it.
+ */
+static void quark_index_grow(void)
 {
 	quark_t q;
 
+	mem_free(quark_index);
+	alloc_index *= 2;
+	quark_index = C_ZNEW(alloc_index, quark_t);
+
 	for (q = 1; q < nr_quarks; q++)
+		quark_index[quark_slot(quarks[q])] = q;
+}
+
+/*
+ * Copy 'str' into the string arena.
+ */
+static char *quark_arena_copy(const char *str)
+{
+	size_t len = strlen(str) + 1;
+	char *copy;
+
+	if (arena_used + len > arena_size)
 	{
-		if (!strcmp(quarks[q], str))
-			return q;
+		size_t size = MAX(ARENA_BLOCK_SIZE, sizeof(char *) + len);
+		char *block = mem_alloc(size);
+
+		/* Chain to the previous block */
+		memcpy(block, &arena_block, sizeof(char *));
+		arena_block = block;
+		arena_used = sizeof(char *);
+		arena_size = size;
 	}
 
+	copy = arena_block + arena_used;
+	memcpy(copy, str, len);
+	arena_used += len;
+
+	return copy;
+}
+
+quark_t quark_add(const char *str)
+{
+	quark_t q;
+	size_t slot = quark_slot(str);
+
+	if (quark_index[slot])
+		return quark_index[slot];
+
 	if (nr_quarks == alloc_quarks)
 	{
 		alloc_quarks *= 2;
@@ -43,7 +135,12 @@ quark_t quark_add(const char *str)
 	}
 
 	q = nr_quarks++;
-	quarks[q] = string_make(str);
+	quarks[q] = quark_arena_copy(str);
+	quark_index[slot] = q;
+
+	/* Keep the index at most half full */
+	if (nr_quarks * 2 > alloc_index)
+		quark_index_grow();
 
 	return q;
 }
@@ -55,19 +152,29 @@ const char *quark_str(quark_t q)
 
 errr quarks_init(void)
 {
+	nr_quarks = 1;
 	alloc_quarks = QUARKS_INIT;
 	quarks = C_ZNEW(alloc_quarks, char *);
 
+	alloc_index = QUARK_INDEX_INIT;
+	quark_index = C_ZNEW(alloc_index, quark_t);
+
 	return 0;
 }
 
 errr quarks_free(void)
 {
-	size_t i;
+	while (arena_block)
+	{
+		char *prev;
 
-	for (i = 0; i < nr_quarks; i++)
-		string_free(quarks[i]);
+		memcpy(&prev, arena_block, sizeof(char *));
+		mem_free(arena_block);
+		arena_block = prev;
+	}
+	arena_used = arena_size = 0;
 
+	FREE(quark_index);
 	FREE(quarks);
 	return 0;
 }
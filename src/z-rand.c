@@ -18,6 +18,7 @@
  *    are included in all such copies.  Other copyrights may also apply.
  */
 #include "z-rand.h"
+#include "z-virt.h"
 
 /**
  * This file provides a pseudo-random number generator.
@@ -101,6 +102,9 @@ static u32b rand_fixval = 0;
 void Rand_state_init(u32b seed) {
 	int i, j;
 
+	/* Start from a known index, so the seed alone determines the state */
+	state_i = 0;
+
 	/* Seed the table */
 	STATE[0] = seed;
 
@@ -467,6 +471,98 @@ bool randcalc_varies(random_value v) {
 	return randcalc(v, 0, MINIMISE) != randcalc(v, 0, MAXIMISE);
 }
 
+
+/**
+ * Make room for `size` entries in an alias table
+ */
+void Rand_alias_init(struct alias_table *t, int size) {
+	if (size > t->size) {
+		t->prob = mem_realloc(t->prob, size * sizeof(*t->prob));
+		t->alias = mem_realloc(t->alias, size * sizeof(*t->alias));
+	}
+
+	t->size = size;
+	t->total = 0;
+	memset(t->prob, 0, size * sizeof(*t->prob));
+}
+
+/**
+ * Build an alias table from the weights in prob[] (Vose's method).
+ *
+ * Every weight is scaled by `size`, so that the columns each hold `total`
+ * units.  Columns below `total` are topped up from one above it, which
+ * becomes their alias, until every column is exactly full.
+ */
+void Rand_alias_build(struct alias_table *t) {
+	int *small, *large;
+	int n_small = 0, n_large = 0;
+	int i;
+
+	t->total = 0;
+	for (i = 0; i < t->size; i++) {
+		t->total += t->prob[i];
+		t->prob[i] *= t->size;
+		t->alias[i] = i;
+	}
+
+	if (!t->total) return;
+
+	/* The product of weights and size must not overflow */
+	assert(t->total <= 0xFFFFFFFFUL / t->size);
+
+	small = mem_alloc(t->size * sizeof(*small));
+	large = mem_alloc(t->size * sizeof(*large));
+
+	for (i = 0; i < t->size; i++) {
+		if (t->prob[i] < t->total)
+			small[n_small++] = i;
+		else
+			large[n_large++] = i;
+	}
+
+	while (n_small && n_large) {
+		int s = small[--n_small];
+		int l = large[n_large - 1];
+
+		/* Fill column s from l */
+		t->alias[s] = l;
+		t->prob[l] -= t->total - t->prob[s];
+
+		if (t->prob[l] < t->total) {
+			n_large--;
+			small[n_small++] = l;
+		}
+	}
+
+	/* Integer arithmetic leaves whatever is left exactly full */
+	while (n_large) t->prob[large[--n_large]] = t->total;
+	while (n_small) t->prob[small[--n_small]] = t->total;
+
+	mem_free(small);
+	mem_free(large);
+}
+
+/**
+ * Pick an entry from an alias table
+ */
+int Rand_alias(const struct alias_table *t) {
+	int i;
+
+	if (!t->total) return -1;
+
+	i = randint0(t->size);
+	return (Rand_div(t->total) < t->prob[i]) ? i : t->alias[i];
+}
+
+/**
+ * Free the storage of an alias table
+ */
+void Rand_alias_free(struct alias_table *t) {
+	mem_free(t->prob);
+	mem_free(t->alias);
+	memset(t, 0, sizeof(*t));
+}
+
 void rand_fix(u32b val) {
 	rand_fixed = TRUE;
 	rand_fixval = val;
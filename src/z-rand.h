@@ -22,6 +22,21 @@ typedef struct random {
  */
 #define RAND_DEG 32
 
+/**
+ * An alias table (Vose's method) for picking one of `size` entries with
+ * given integer weights in constant time.
+ *
+ * Each of the `size` columns holds `total` units: prob[i] of them pick i,
+ * and the rest pick alias[i].  All the arithmetic is done in integers, so
+ * the chance of each entry is exactly its weight divided by `total`.
+ */
+struct alias_table {
+	int size;
+	u32b total;
+	u32b *prob;
+	int *alias;
+};
+
 /* Random aspects used by damcalc, m_bonus_calc, and ranvals */
 typedef enum {
 	MINIMISE,
@@ -149,6 +164,27 @@ bool randcalc_valid(random_value v, int test);
  */
 bool randcalc_varies(random_value v);
 
+/**
+ * Make room for `size` entries in an alias table, with all weights zero.
+ * The weights are then written to prob[] before calling Rand_alias_build().
+ */
+void Rand_alias_init(struct alias_table *t, int size);
+
+/**
+ * Turn the weights in prob[] into a finished alias table.
+ */
+void Rand_alias_build(struct alias_table *t);
+
+/**
+ * Pick an entry from an alias table, or -1 if all the weights are zero.
+ */
+int Rand_alias(const struct alias_table *t);
+
+/**
+ * Free the storage of an alias table.
+ */
+void Rand_alias_free(struct alias_table *t);
+
 #ifdef TEST
 extern void rand_fix(u32b val);
 #endif